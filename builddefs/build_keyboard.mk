@@ -569,6 +569,18 @@ top-symbols: build
 	echo "###########################################"
 endif
 
+RGB_MATRIX_EFFECT_NAMES = $(shell sed -n 's/^RGB_MATRIX_EFFECT(\([A-Za-z0-9_]*\)).*/\1/p' $(QUANTUM_PATH)/rgb_matrix/animations/*.h $(wildcard $(addsuffix /rgb_matrix_*.inc,$(VPATH))))
+rgb-matrix-effect-sizes: build
+	echo "###########################################"
+	echo "# RGB Matrix effect flash usage:"
+	$(NM) -Crtd --size-sort $(BUILD_DIR)/$(TARGET).elf | grep ' [Tt] ' | grep -w $(addprefix -e ,$(RGB_MATRIX_EFFECT_NAMES)) | sed -e 's#^0000000#       #g' -e 's#^000000#      #g' -e 's#^00000#     #g' -e 's#^0000#    #g' -e 's#^000#   #g' -e 's#^00#  #g' -e 's#^0# #g' || true
+	echo "###########################################"
+
+ifeq ($(strip $(RGB_MATRIX_EFFECT_SIZES)),yes)
+all: rgb-matrix-effect-sizes
+check-size: rgb-matrix-effect-sizes
+endif
+
 include $(BUILDDEFS_PATH)/show_options.mk
 include $(BUILDDEFS_PATH)/common_rules.mk
 
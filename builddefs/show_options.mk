@@ -9,6 +9,7 @@ BUILD_OPTION_NAMES = \
   DEBOUNCE_TYPE \
   SPLIT_KEYBOARD \
   DYNAMIC_KEYMAP_ENABLE \
+  DYNAMIC_KEYMAP_BULK_ENABLE \
   USB_HID_ENABLE \
   VIA_ENABLE
 
@@ -362,7 +362,9 @@ bool oled_init(oled_rotation_t rotation) {
     oled_scroll_timeout = timer_read32() + OLED_SCROLL_TIMEOUT;
 #endif
 
+    // Display RAM contents are unknown after initialisation, so everything needs sending
     oled_clear();
+    oled_dirty       = OLED_ALL_BLOCKS_MASK;
     oled_initialized = true;
     oled_active      = true;
     oled_scrolling   = false;
@@ -377,12 +379,32 @@ __attribute__((weak)) oled_rotation_t oled_init_user(oled_rotation_t rotation) {
 }
 
 void oled_clear(void) {
+    // Only blocks which currently hold something need to be redrawn
+    for (uint8_t i = 0; i < OLED_BLOCK_COUNT; ++i) {
+        const uint8_t *block = &oled_buffer[OLED_BLOCK_SIZE * i];
+        for (uint16_t j = 0; j < OLED_BLOCK_SIZE; ++j) {
+            if (block[j]) {
+                oled_dirty |= ((OLED_BLOCK_TYPE)1 << i);
+                break;
+            }
+        }
+    }
     memset(oled_buffer, 0, sizeof(oled_buffer));
     oled_cursor = &oled_buffer[0];
-    oled_dirty  = OLED_ALL_BLOCKS_MASK;
 }
 
-static void calc_bounds(uint8_t update_start, uint8_t *cmd_array) {
+static bool can_extend_update(uint8_t update_start, uint8_t update_count) {
+#if OLED_IC_HAS_HORIZONTAL_MODE
+    // Whole-page blocks can always be sent in a single window
+    if (OLED_BLOCK_SIZE % OLED_DISPLAY_WIDTH == 0) {
+        return true;
+    }
+#endif
+    // Otherwise the run must stay within the page it started on
+    return (uint16_t)OLED_BLOCK_SIZE * update_start / OLED_DISPLAY_WIDTH == ((uint16_t)OLED_BLOCK_SIZE * (update_start + update_count + 1) - 1) / OLED_DISPLAY_WIDTH;
+}
+
+static void calc_bounds(uint8_t update_start, uint8_t update_count, uint8_t *cmd_array) {
     // Calculate commands to set memory addressing bounds.
     uint8_t start_page   = OLED_BLOCK_SIZE * update_start / OLED_DISPLAY_WIDTH;
     uint8_t start_column = OLED_BLOCK_SIZE * update_start % OLED_DISPLAY_WIDTH;
@@ -394,10 +416,11 @@ static void calc_bounds(uint8_t update_start, uint8_t *cmd_array) {
     cmd_array[2] = PAM_SETCOLUMN_MSB | ((OLED_COLUMN_OFFSET + start_column) >> 4 & 0x0f);
 #else
     // Commands for use in Horizontal Addressing mode.
-    cmd_array[1] = start_column + OLED_COLUMN_OFFSET;
-    cmd_array[4] = start_page;
-    cmd_array[2] = (OLED_BLOCK_SIZE + OLED_DISPLAY_WIDTH - 1) % OLED_DISPLAY_WIDTH + cmd_array[1];
-    cmd_array[5] = (OLED_BLOCK_SIZE + OLED_DISPLAY_WIDTH - 1) / OLED_DISPLAY_WIDTH - 1 + cmd_array[4];
+    uint16_t update_size = (uint16_t)OLED_BLOCK_SIZE * update_count;
+    cmd_array[1]         = start_column + OLED_COLUMN_OFFSET;
+    cmd_array[4]         = start_page;
+    cmd_array[2]         = (update_size + OLED_DISPLAY_WIDTH - 1) % OLED_DISPLAY_WIDTH + cmd_array[1];
+    cmd_array[5]         = (update_size + OLED_DISPLAY_WIDTH - 1) / OLED_DISPLAY_WIDTH - 1 + cmd_array[4];
 #endif
 }
 
@@ -431,18 +454,22 @@ static void calc_bounds_90(uint8_t update_start, uint8_t *cmd_array) {
 #endif
 }
 
-uint8_t crot(uint8_t a, int8_t n) {
-    const uint8_t mask = 0x7;
-    n &= mask;
-    return a << n | a >> (-n & mask);
-}
+// Spreads the bits of a nibble into bit 0 of successive bytes
+static const uint32_t PROGMEM nibble_spread[16] = {
+    0x00000000, 0x00000001, 0x00000100, 0x00000101, 0x00010000, 0x00010001, 0x00010100, 0x00010101,
+    0x01000000, 0x01000001, 0x01000100, 0x01000101, 0x01010000, 0x01010001, 0x01010100, 0x01010101,
+};
 
+// Transposes an 8x8 block so that bit i of src[j] ends up as bit (7 - j) of dest[i]
 static void rotate_90(const uint8_t *src, uint8_t *dest) {
-    for (uint8_t i = 0, shift = 7; i < 8; ++i, --shift) {
-        uint8_t selector = (1 << i);
-        for (uint8_t j = 0; j < 8; ++j) {
-            dest[i] |= crot(src[j] & selector, shift - (int8_t)j);
-        }
+    uint32_t low = 0, high = 0;
+    for (uint8_t j = 0; j < 8; ++j) {
+        low |= pgm_read_dword(&nibble_spread[src[j] & 0x0F]) << (7 - j);
+        high |= pgm_read_dword(&nibble_spread[src[j] >> 4]) << (7 - j);
+    }
+    for (uint8_t i = 0; i < 4; ++i) {
+        dest[i] |= (uint8_t)(low >> (8 * i));
+        dest[i + 4] |= (uint8_t)(high >> (8 * i));
     }
 }
 
@@ -464,6 +491,14 @@ void oled_render_dirty(bool all) {
             ++update_start;
         }
 
+        // Unrotated blocks are contiguous in the display's memory, so send any dirty neighbours in the same transfer
+        uint8_t update_count = 1;
+        if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
+            while (update_start + update_count < OLED_BLOCK_COUNT && (oled_dirty & ((OLED_BLOCK_TYPE)1 << (update_start + update_count))) && can_extend_update(update_start, update_count)) {
+                ++update_count;
+            }
+        }
+
         // Set column & page position
 #if OLED_IC_HAS_HORIZONTAL_MODE
         static uint8_t display_start[] = {I2C_CMD, COLUMN_ADDR, 0, OLED_DISPLAY_WIDTH - 1, PAGE_ADDR, 0, OLED_DISPLAY_HEIGHT / 8 - 1};
@@ -471,7 +506,7 @@ void oled_render_dirty(bool all) {
         static uint8_t display_start[] = {I2C_CMD, PAM_PAGE_ADDR, PAM_SETCOLUMN_LSB, PAM_SETCOLUMN_MSB};
 #endif
         if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
-            calc_bounds(update_start, &display_start[1]); // Offset from I2C_CMD byte at the start
+            calc_bounds(update_start, update_count, &display_start[1]); // Offset from I2C_CMD byte at the start
         } else {
             calc_bounds_90(update_start, &display_start[1]); // Offset from I2C_CMD byte at the start
         }
@@ -484,7 +519,7 @@ void oled_render_dirty(bool all) {
 
         if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
             // Send render data chunk as is
-            if (!oled_send_data(&oled_buffer[OLED_BLOCK_SIZE * update_start], OLED_BLOCK_SIZE)) {
+            if (!oled_send_data(&oled_buffer[OLED_BLOCK_SIZE * update_start], (uint16_t)OLED_BLOCK_SIZE * update_count)) {
                 print("oled_render data failed\n");
                 return;
             }
@@ -527,8 +562,10 @@ void oled_render_dirty(bool all) {
 #endif
         }
 
-        // Clear dirty flag of just rendered block
-        oled_dirty &= ~((OLED_BLOCK_TYPE)1 << update_start);
+        // Clear dirty flags of just rendered blocks
+        while (update_count--) {
+            oled_dirty &= ~((OLED_BLOCK_TYPE)1 << update_start++);
+        }
     }
 }
 
@@ -24,6 +24,11 @@
      qadd8( i, j) == MIN( (i + j), 0xFF )
      qsub8( i, j) == MAX( (i - j), 0 )
 
+ - The same saturating add and subtract, and scale8, applied
+   to four bytes packed into a uint32_t at once. Each byte
+   gives exactly the same result as the single byte version.
+     qadd8x4( i, j), qsub8x4( i, j), scale8x4( i, sc)
+
  - Saturating signed 8-bit ("7-bit") add.
      qadd7( i, j) == MIN( (i + j), 0x7F)
 
@@ -183,13 +188,32 @@ Lib8tion is pronounced like 'libation': lie-BAY-shun
 #define QADD7_C 0
 #define QADD8_ARM_DSP_ASM 1
 #define QADD7_ARM_DSP_ASM 1
+#elif defined(__ARM_FEATURE_DSP)
+// Cortex M4/M7 -- uqadd8 matches the C version exactly, but the signed
+// qadd8 also saturates at -128 where qadd7_C wraps, so qadd7 stays in C
+#define QADD8_C 0
+#define QADD7_C 1
+#define QADD8_ARM_DSP_ASM 1
 #else
 // Generic ARM
 #define QADD8_C 1
 #define QADD7_C 1
 #endif
 
+#if defined(__ARM_FEATURE_DSP)
+#define QSUB8_C 0
+#define QSUB8_ARM_DSP_ASM 1
+#define QADD8X4_ARM_DSP_ASM 1
+#define QSUB8X4_ARM_DSP_ASM 1
+#else
 #define QSUB8_C 1
+#endif
+
+#if defined(__ARM_ARCH_6M__)
+// Cortex M0/M0+ -- a table is cheaper than the branches in sin8_C
+#define SIN8_LUT 1
+#endif
+
 #define SCALE8_C 1
 #define SCALE16BY8_C 1
 #define SCALE16_C 1
@@ -108,11 +108,45 @@ LIB8STATIC_ALWAYS_INLINE uint8_t qsub8( uint8_t i, uint8_t j)
          : "a"  (j) );
 
     return i;
+#elif QSUB8_ARM_DSP_ASM == 1
+    asm volatile( "uqsub8 %0, %0, %1" : "+r" (i) : "r" (j));
+    return i;
 #else
 #error "No implementation for qsub8 available."
 #endif
 }
 
+/// qadd8 applied to each of the four bytes packed into i and j
+LIB8STATIC_ALWAYS_INLINE uint32_t qadd8x4( uint32_t i, uint32_t j)
+{
+#if QADD8X4_ARM_DSP_ASM == 1
+    asm volatile( "uqadd8 %0, %0, %1" : "+r" (i) : "r" (j));
+    return i;
+#else
+    // Add the low 7 bits of each byte, which can't carry into the next byte,
+    // then work out the top bit and whether each byte overflowed
+    uint32_t low   = (i & 0x7F7F7F7F) + (j & 0x7F7F7F7F);
+    uint32_t sum   = low ^ ((i ^ j) & 0x80808080);
+    uint32_t carry = ((i & j) | ((i | j) & low)) & 0x80808080;
+    return sum | ((carry >> 7) * 0xFF);
+#endif
+}
+
+/// qsub8 applied to each of the four bytes packed into i and j
+LIB8STATIC_ALWAYS_INLINE uint32_t qsub8x4( uint32_t i, uint32_t j)
+{
+#if QSUB8X4_ARM_DSP_ASM == 1
+    asm volatile( "uqsub8 %0, %0, %1" : "+r" (i) : "r" (j));
+    return i;
+#else
+    // Setting the top bit of each byte of i stops borrows crossing into the
+    // next byte, then fix up the top bit and find which bytes went below zero
+    uint32_t diff   = ((i | 0x80808080) - (j & 0x7F7F7F7F)) ^ ((i ^ ~j) & 0x80808080);
+    uint32_t borrow = ((~i & j) | (~(i ^ j) & diff)) & 0x80808080;
+    return diff & ~((borrow >> 7) * 0xFF);
+#endif
+}
+
 /// add one byte to another, with one byte result
 LIB8STATIC_ALWAYS_INLINE uint8_t add8( uint8_t i, uint8_t j)
 {
@@ -89,6 +89,21 @@ LIB8STATIC_ALWAYS_INLINE uint8_t scale8( uint8_t i, fract8 scale)
 #endif
 }
 
+/// scale8 applied to each of the four bytes packed into i.
+/// Even and odd bytes are each spread out to 16 bits, so one 32-bit
+/// multiply scales two bytes without their products overlapping.
+LIB8STATIC_ALWAYS_INLINE uint32_t scale8x4( uint32_t i, fract8 scale)
+{
+#if (FASTLED_SCALE8_FIXED == 1)
+    uint32_t factor = (uint32_t)scale + 1;
+#else
+    uint32_t factor = scale;
+#endif
+    uint32_t even = (((i & 0x00FF00FF) * factor) >> 8) & 0x00FF00FF;
+    uint32_t odd  = (((i >> 8) & 0x00FF00FF) * factor) & 0xFF00FF00;
+    return even | odd;
+}
+
 
 ///  The "video" version of scale8 guarantees that the output will
 ///  be only be zero if one or both of the inputs are zero.  If both
@@ -0,0 +1,92 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "lib8tion.h"
+}
+
+// Exhaustive checks that the specialised kernels give exactly the same results
+// as the plain C versions for every input.
+
+// Places a under test in one byte of a packed word, with the other bytes set
+// to values derived from a so that every lane sees a mix of neighbours
+static uint32_t pack_around(uint8_t a, uint8_t lane) {
+    uint32_t packed = 0;
+    for (uint8_t k = 0; k < 4; k++) {
+        uint8_t value = k == lane ? a : (uint8_t)(a * (k + 3) + 0x5A * k);
+        packed |= (uint32_t)value << (k * 8);
+    }
+    return packed;
+}
+
+static uint8_t lane_of(uint32_t packed, uint8_t lane) {
+    return (packed >> (lane * 8)) & 0xFF;
+}
+
+TEST(Lib8tion, Qadd8MatchesReference) {
+    for (int i = 0; i < 256; i++) {
+        for (int j = 0; j < 256; j++) {
+            ASSERT_EQ(qadd8(i, j), std::min(i + j, 0xFF)) << i << " + " << j;
+        }
+    }
+}
+
+TEST(Lib8tion, Qsub8MatchesReference) {
+    for (int i = 0; i < 256; i++) {
+        for (int j = 0; j < 256; j++) {
+            ASSERT_EQ(qsub8(i, j), std::max(i - j, 0)) << i << " - " << j;
+        }
+    }
+}
+
+TEST(Lib8tion, Qadd8x4MatchesQadd8) {
+    for (uint16_t i = 0; i < 256; i++) {
+        for (uint16_t j = 0; j < 256; j++) {
+            for (uint8_t lane = 0; lane < 4; lane++) {
+                uint32_t a = pack_around(i, lane), b = pack_around(j, 3 - lane);
+                uint32_t r = qadd8x4(a, b);
+                for (uint8_t k = 0; k < 4; k++) {
+                    ASSERT_EQ(lane_of(r, k), qadd8(lane_of(a, k), lane_of(b, k))) << i << " + " << j << " lane " << (int)k;
+                }
+            }
+        }
+    }
+}
+
+TEST(Lib8tion, Qsub8x4MatchesQsub8) {
+    for (uint16_t i = 0; i < 256; i++) {
+        for (uint16_t j = 0; j < 256; j++) {
+            for (uint8_t lane = 0; lane < 4; lane++) {
+                uint32_t a = pack_around(i, lane), b = pack_around(j, 3 - lane);
+                uint32_t r = qsub8x4(a, b);
+                for (uint8_t k = 0; k < 4; k++) {
+                    ASSERT_EQ(lane_of(r, k), qsub8(lane_of(a, k), lane_of(b, k))) << i << " - " << j << " lane " << (int)k;
+                }
+            }
+        }
+    }
+}
+
+TEST(Lib8tion, Scale8x4MatchesScale8) {
+    for (uint16_t i = 0; i < 256; i++) {
+        for (uint16_t scale = 0; scale < 256; scale++) {
+            for (uint8_t lane = 0; lane < 4; lane++) {
+                uint32_t a = pack_around(i, lane);
+                uint32_t r = scale8x4(a, scale);
+                for (uint8_t k = 0; k < 4; k++) {
+                    ASSERT_EQ(lane_of(r, k), scale8(lane_of(a, k), scale)) << i << " * " << scale << " lane " << (int)k;
+                }
+            }
+        }
+    }
+}
+
+TEST(Lib8tion, Sin8LutMatchesSin8C) {
+    for (uint16_t theta = 0; theta < 256; theta++) {
+        ASSERT_EQ(sin8_lut(theta), sin8_C(theta)) << theta;
+        ASSERT_EQ(cos8(theta), sin8_C(theta + 64)) << theta;
+    }
+}
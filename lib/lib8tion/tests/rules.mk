@@ -0,0 +1,8 @@
+lib8tion_DEFS := -DSIN8_LUT=1
+
+lib8tion_INC := \
+	$(LIB_PATH)/lib8tion
+
+lib8tion_SRC := \
+	$(LIB_PATH)/lib8tion/lib8tion.c \
+	$(LIB_PATH)/lib8tion/tests/lib8tion_tests.cpp
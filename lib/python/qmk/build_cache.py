@@ -0,0 +1,153 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+"""Content-hash cache of compiled firmware, used to skip unchanged targets.
+
+A target's cache key covers everything that can influence its output:
+
+* the shared sources (quantum/, tmk_core/, platforms/, drivers/, builddefs/, lib/, ...)
+* the top-level keyboard folder the target lives in
+* the resolved keymap json, and the keymap directory if it lives on disk
+* the build environment and per-target extra arguments
+* the installed toolchain versions
+"""
+import hashlib
+import json
+import shutil
+import subprocess
+from functools import lru_cache
+from pathlib import Path
+from typing import Dict, List, Optional
+
+from qmk.constants import QMK_FIRMWARE
+from qmk.build_targets import BuildTarget, KeyboardKeymapBuildTarget
+from qmk.keymap import locate_keymap
+
+CACHE_DIR = Path(QMK_FIRMWARE) / '.build' / 'cache'
+FIRMWARE_EXTENSIONS = ['hex', 'bin', 'uf2']
+
+# Paths shared by every target. Anything changing in here invalidates the whole cache.
+SHARED_PATHS = ['Makefile', 'paths.mk', 'builddefs', 'data', 'drivers', 'lib', 'layouts', 'platforms', 'quantum', 'tmk_core', 'users']
+
+# Compilers whose version string contributes to the key, whichever are installed.
+TOOLCHAINS = ['avr-gcc', 'arm-none-eabi-gcc', 'riscv32-unknown-elf-gcc', 'riscv64-unknown-elf-gcc', 'gcc']
+
+
+def _git(*args: str) -> str:
+    return subprocess.run(['git', *args], cwd=QMK_FIRMWARE, capture_output=True, check=True, text=True).stdout
+
+
+def _tree_digest(paths: List[str]) -> str:
+    """Hashes the git index entries for the supplied paths, along with the content of any locally modified or untracked files.
+    """
+    h = hashlib.sha256()
+    h.update(_git('ls-files', '-s', '--', *paths).encode())
+    for name in sorted(set(_git('ls-files', '-m', '-o', '--exclude-standard', '--', *paths).splitlines())):
+        file = Path(QMK_FIRMWARE) / name
+        h.update(name.encode())
+        if file.is_file():
+            h.update(file.read_bytes())
+    return h.hexdigest()
+
+
+def _directory_digest(path: Path) -> str:
+    """Hashes every file under a directory which isn't tracked by the QMK repo's git index, e.g. userspace keymaps.
+    """
+    h = hashlib.sha256()
+    for file in sorted(p for p in path.rglob('*') if p.is_file()):
+        h.update(file.relative_to(path).as_posix().encode())
+        h.update(file.read_bytes())
+    return h.hexdigest()
+
+
+@lru_cache(maxsize=None)
+def shared_digest() -> str:
+    """Digest of the sources shared by all targets, computed once per invocation.
+    """
+    return _tree_digest(SHARED_PATHS)
+
+
+@lru_cache(maxsize=None)
+def toolchain_digest() -> str:
+    """Digest of the versions of all installed toolchains.
+    """
+    h = hashlib.sha256()
+    for compiler in TOOLCHAINS:
+        if shutil.which(compiler):
+            version = subprocess.run([compiler, '--version'], capture_output=True, text=True).stdout.splitlines()
+            h.update(f'{compiler}:{version[0] if version else ""}'.encode())
+    return h.hexdigest()
+
+
+@lru_cache(maxsize=None)
+def keyboard_digest(top_level_folder: str) -> str:
+    """Digest of a top-level keyboard folder, shared by every target underneath it.
+    """
+    return _tree_digest([f'keyboards/{top_level_folder}'])
+
+
+def _keymap_digest(target: BuildTarget, env: Dict[str, str]) -> str:
+    h = hashlib.sha256()
+    h.update(json.dumps(target.json, sort_keys=True, separators=(',', ':')).encode())
+
+    if isinstance(target, KeyboardKeymapBuildTarget):
+        keymap_location = locate_keymap(target.keyboard, target.keymap, force_layout={**env, **target.extra_args}.get('FORCE_LAYOUT'))
+        if keymap_location:
+            keymap_dir = Path(keymap_location).parent
+            try:
+                # Keymaps inside the repo are tracked by the git index...
+                h.update(_tree_digest([keymap_dir.relative_to(QMK_FIRMWARE).as_posix()]).encode())
+            except ValueError:
+                # ...whereas anything else needs to be hashed by content.
+                h.update(_directory_digest(keymap_dir).encode())
+
+    return h.hexdigest()
+
+
+def cache_key(target: BuildTarget, **env: str) -> Optional[str]:
+    """Returns the cache key for a target, or None if one could not be determined.
+    """
+    try:
+        h = hashlib.sha256()
+        h.update(shared_digest().encode())
+        h.update(toolchain_digest().encode())
+        h.update(keyboard_digest(target.keyboard.split('/')[0]).encode())
+        h.update(_keymap_digest(target, env).encode())
+        h.update(json.dumps({'env': env, 'extra_args': target.extra_args}, sort_keys=True).encode())
+        return h.hexdigest()
+    except (OSError, subprocess.CalledProcessError):
+        return None
+
+
+def cache_path(key: str) -> Path:
+    return CACHE_DIR / key[:2] / key
+
+
+def restore(key: str, target_filename: str) -> bool:
+    """Copies a previously cached firmware into the qmk_firmware folder, returning whether or not there was a cache hit.
+    """
+    entry = cache_path(key)
+    firmware = [entry / f'{target_filename}.{ext}' for ext in FIRMWARE_EXTENSIONS]
+    firmware = [f for f in firmware if f.exists()]
+    if len(firmware) == 0:
+        return False
+
+    for f in firmware:
+        shutil.copy2(f, Path(QMK_FIRMWARE) / f.name)
+    return True
+
+
+def store_recipe(key: str, target_filename: str, build_log: str, failed_log: str, build_stamp: str) -> str:
+    """Returns the make recipe lines which store a target's firmware in the cache once it has been built.
+
+    Only clean builds are stored, as a cache hit has no way to replay the warnings of the original build. Firmware older than `build_stamp` is left over from an earlier build, so isn't stored either.
+    """
+    cache_dir = cache_path(key)
+    extensions = ' '.join(FIRMWARE_EXTENSIONS)
+    # yapf: disable
+    return f"""\
+	@[ -f "{failed_log}" ] || grep -e '\\[ERRORS\\]' -e '\\[WARNINGS\\]' "{build_log}" >/dev/null 2>&1 || for ext in {extensions}; do \\
+		[ -f "{QMK_FIRMWARE}/{target_filename}.$$ext" ] && [ ! "{build_stamp}" -nt "{QMK_FIRMWARE}/{target_filename}.$$ext" ] || continue; \\
+		mkdir -p "{cache_dir}" && cp -f "{QMK_FIRMWARE}/{target_filename}.$$ext" "{cache_dir}/" 2>/dev/null || true; \\
+	done
+"""  # noqa
+    # yapf: enable
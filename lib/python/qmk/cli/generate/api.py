@@ -8,7 +8,7 @@ from milc import cli
 
 import qmk.path
 from qmk.datetime import current_datetime
-from qmk.info import info_json
+from qmk.info import info_json_bulk
 from qmk.json_schema import json_load
 from qmk.keymap import list_keymaps
 from qmk.keyboard import find_readme, list_keyboards, keyboard_alias_definitions
@@ -116,8 +116,9 @@ def generate_api(cli):
     usb_list = {}
 
     # Generate and write keyboard specific JSON files
+    kb_info = info_json_bulk(keyboard_list)
     for keyboard_name in keyboard_list:
-        kb_json = info_json(keyboard_name)
+        kb_json = kb_info[keyboard_name]
         kb_all[keyboard_name] = kb_json
 
         keyboard_dir = v1_dir / 'keyboards' / keyboard_name
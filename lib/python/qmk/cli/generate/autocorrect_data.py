@@ -165,32 +165,52 @@ def check_typo_against_dictionary(typo: str, line_number: int, correct_words) ->
                 cli.log.warning('{fg_yellow}Warning:%d:{fg_reset} Typo "{fg_cyan}%s{fg_reset}" would falsely trigger on correctly spelled word "{fg_cyan}%s{fg_reset}".', line_number, typo, word)
 
 
-def serialize_trie(autocorrections: List[Tuple[str, str]], trie: Dict[str, Any]) -> List[int]:
+def serialize_trie(autocorrections: List[Tuple[str, str]], trie: Dict[str, Any]) -> Tuple[List[int], int]:
     """Serializes trie and correction data in a form readable by the C code.
+  Identical subtrees, such as typos sharing the same correction suffix, are
+  only serialized once and linked to from every branch that reaches them.
   Args:
     autocorrections: List of (typo, correction) tuples.
     trie: Dict of dicts.
   Returns:
-    List of ints in the range 0-255.
+    Tuple of the list of ints in the range 0-255, and the size in bytes of
+    each node link.
   """
     table = []
+    shared = {}
+    keys = {}
+
+    def leaf_data(leaf: Tuple[str, str]) -> List[int]:
+        typo, correction = leaf
+        word_boundary_ending = typo[-1] == ':'
+        typo = typo.strip(':')
+        i = 0  # Make the autocorrection data for this entry and serialize it.
+        while i < min(len(typo), len(correction)) and typo[i] == correction[i]:
+            i += 1
+        backspaces = len(typo) - i - 1 + word_boundary_ending
+        assert 0 <= backspaces <= 63
+        correction = correction[i:]
+        bs_count = [backspaces + 128]
+        return bs_count + list(bytes(correction, 'ascii')) + [0]
+
+    def subtree_key(trie_node):
+        """Returns a hashable key that is equal for subtrees serializing to the same bytes."""
+        if id(trie_node) not in keys:
+            if 'LEAF' in trie_node:
+                keys[id(trie_node)] = tuple(leaf_data(trie_node['LEAF']))
+            else:
+                keys[id(trie_node)] = tuple((c, subtree_key(child)) for c, child in sorted(trie_node.items()))
+        return keys[id(trie_node)]
+
+    # Traverse trie in depth first order. Nodes that follow a chain are
+    # encoded immediately after it, so those are never replaced by a link.
+    def traverse(trie_node, inline=False):
+        key = subtree_key(trie_node)
+        if not inline and key in shared:
+            return shared[key]
 
-    # Traverse trie in depth first order.
-    def traverse(trie_node):
         if 'LEAF' in trie_node:  # Handle a leaf trie node.
-            typo, correction = trie_node['LEAF']
-            word_boundary_ending = typo[-1] == ':'
-            typo = typo.strip(':')
-            i = 0  # Make the autocorrection data for this entry and serialize it.
-            while i < min(len(typo), len(correction)) and typo[i] == correction[i]:
-                i += 1
-            backspaces = len(typo) - i - 1 + word_boundary_ending
-            assert 0 <= backspaces <= 63
-            correction = correction[i:]
-            bs_count = [backspaces + 128]
-            data = bs_count + list(bytes(correction, 'ascii')) + [0]
-
-            entry = {'data': data, 'links': [], 'byte_offset': 0}
+            entry = {'data': leaf_data(trie_node['LEAF']), 'links': [], 'byte_offset': 0}
             table.append(entry)
         elif len(trie_node) == 1:  # Handle trie node with a single child.
             c, trie_node = next(iter(trie_node.items()))
@@ -203,16 +223,18 @@ def serialize_trie(autocorrections: List[Tuple[str, str]], trie: Dict[str, Any])
                 entry['chars'] += c
 
             table.append(entry)
-            entry['links'] = [traverse(trie_node)]
+            entry['links'] = [traverse(trie_node, inline=True)]
         else:  # Handle trie node with multiple children.
             entry = {'chars': ''.join(sorted(trie_node.keys())), 'byte_offset': 0}
             table.append(entry)
             entry['links'] = [traverse(trie_node[c]) for c in entry['chars']]
+
+        shared[key] = entry
         return entry
 
     traverse(trie)
 
-    def serialize(e: Dict[str, Any]) -> List[int]:
+    def serialize(e: Dict[str, Any], link_bytes: int) -> List[int]:
         if not e['links']:  # Handle a leaf table entry.
             return e['data']
         elif len(e['links']) == 1:  # Handle a chain table entry.
@@ -220,25 +242,33 @@ def serialize_trie(autocorrections: List[Tuple[str, str]], trie: Dict[str, Any])
         else:  # Handle a branch table entry.
             data = []
             for c, link in zip(e['chars'], e['links']):
-                data += [TYPO_CHARS[c] | (0 if data else 64)] + encode_link(link)
+                data += [TYPO_CHARS[c] | (0 if data else 64)] + encode_link(link, link_bytes)
             return data + [0]
 
-    byte_offset = 0
-    for e in table:  # To encode links, first compute byte offset of each entry.
-        e['byte_offset'] = byte_offset
-        byte_offset += len(serialize(e))
-        assert 0 <= byte_offset <= 0xffff
+    def entry_size(e: Dict[str, Any], link_bytes: int) -> int:
+        if len(e['links']) > 1:  # Branch table entries carry a link per child.
+            return len(e['chars']) * (1 + link_bytes) + 1
+        return len(serialize(e, link_bytes))
+
+    # Use 16-bit links where possible, and only widen them once the table outgrows 64KB.
+    for link_bytes in (2, 3):
+        byte_offset = 0
+        for e in table:  # To encode links, first compute byte offset of each entry.
+            e['byte_offset'] = byte_offset
+            byte_offset += entry_size(e, link_bytes)
+        if byte_offset <= 1 << (8 * link_bytes):
+            break
 
-    return [b for e in table for b in serialize(e)]  # Serialize final table.
+    return [b for e in table for b in serialize(e, link_bytes)], link_bytes  # Serialize final table.
 
 
-def encode_link(link: Dict[str, Any]) -> List[int]:
-    """Encodes a node link as two bytes."""
+def encode_link(link: Dict[str, Any], link_bytes: int = 2) -> List[int]:
+    """Encodes a node link as two or three bytes, in little endian order."""
     byte_offset = link['byte_offset']
-    if not (0 <= byte_offset <= 0xffff):
-        cli.log.error('{fg_red}Error:{fg_reset} The autocorrection table is too large, a node link exceeds 64KB limit. Try reducing the autocorrection dict to fewer entries.')
+    if not (0 <= byte_offset < 1 << (8 * link_bytes)):
+        cli.log.error('{fg_red}Error:{fg_reset} The autocorrection table is too large, a node link exceeds 16MB limit. Try reducing the autocorrection dict to fewer entries.')
         maybe_exit(1)
-    return [byte_offset & 255, byte_offset >> 8]
+    return [(byte_offset >> (8 * i)) & 255 for i in range(link_bytes)]
 
 
 def typo_len(e: Tuple[str, str]) -> int:
@@ -258,7 +288,7 @@ def to_hex(b: int) -> str:
 def generate_autocorrect_data(cli):
     autocorrections = parse_file(cli.args.filename)
     trie = make_trie(autocorrections)
-    data = serialize_trie(autocorrections, trie)
+    data, link_bytes = serialize_trie(autocorrections, trie)
 
     current_keyboard = cli.args.keyboard or cli.config.user.keyboard or cli.config.generate_autocorrect_data.keyboard
     current_keymap = cli.args.keymap or cli.config.user.keymap or cli.config.generate_autocorrect_data.keymap
@@ -282,6 +312,7 @@ def generate_autocorrect_data(cli):
     autocorrect_data_h_lines.append(f'#define AUTOCORRECT_MIN_LENGTH {len(min_typo)} // "{min_typo}"')
     autocorrect_data_h_lines.append(f'#define AUTOCORRECT_MAX_LENGTH {len(max_typo)} // "{max_typo}"')
     autocorrect_data_h_lines.append(f'#define DICTIONARY_SIZE {len(data)}')
+    autocorrect_data_h_lines.append(f'#define AUTOCORRECT_LINK_BYTES {link_bytes}')
     autocorrect_data_h_lines.append('')
     autocorrect_data_h_lines.append('static const uint8_t autocorrect_data[DICTIONARY_SIZE] PROGMEM = {')
     autocorrect_data_h_lines.append(textwrap.fill('    %s' % (', '.join(map(to_hex, data))), width=100, subsequent_indent='    '))
@@ -14,9 +14,10 @@ from qmk.commands import find_make, get_make_parallel_args, build_environment
 from qmk.search import search_keymap_targets, search_make_targets
 from qmk.build_targets import BuildTarget, JsonKeymapBuildTarget
 from qmk.util import maybe_exit_config
+from qmk import build_cache
 
 
-def mass_compile_targets(targets: List[BuildTarget], clean: bool, dry_run: bool, no_temp: bool, parallel: int, **env):
+def mass_compile_targets(targets: List[BuildTarget], clean: bool, dry_run: bool, no_temp: bool, parallel: int, cache: bool = False, **env):
     if len(targets) == 0:
         return
 
@@ -37,11 +38,19 @@ def mass_compile_targets(targets: List[BuildTarget], clean: bool, dry_run: bool,
 
         builddir.mkdir(parents=True, exist_ok=True)
         with open(makefile, "w") as f:
+            f.write('.PHONY: all\nall:\n\n')
             for target in sorted(targets, key=lambda t: (t.keyboard, t.keymap)):
                 keyboard_name = target.keyboard
                 keymap_name = target.keymap
                 keyboard_safe = keyboard_name.replace('/', '_')
                 target_filename = target.target_name(**env)
+
+                # Skip anything whose inputs are unchanged since a previous successful build
+                cache_key = build_cache.cache_key(target, **env) if cache else None
+                if cache_key and build_cache.restore(cache_key, target_filename):
+                    cli.echo(f"Build {keyboard_name + ':' + keymap_name:<64} {{fg_cyan}}[CACHED]{{fg_reset}}")
+                    continue
+
                 target.configure(parallel=1)  # We ignore parallelism on a per-build basis as we defer to the parent make invocation
                 target.prepare_build(**env)  # If we've got json targets, allow them to write out any extra info to .build before we kick off `make`
                 command = target.compile_command(**env)
@@ -49,10 +58,12 @@ def mass_compile_targets(targets: List[BuildTarget], clean: bool, dry_run: bool,
                 extra_args = '_'.join([f"{k}_{v}" for k, v in target.extra_args.items()])
                 build_log = f"{QMK_FIRMWARE}/.build/build.log.{os.getpid()}.{keyboard_safe}.{keymap_name}"
                 failed_log = f"{QMK_FIRMWARE}/.build/failed.log.{os.getpid()}.{keyboard_safe}.{keymap_name}"
+                build_stamp = f"{QMK_FIRMWARE}/.build/build.stamp.{os.getpid()}.{keyboard_safe}.{keymap_name}"
                 target_suffix = ''
                 if len(extra_args) > 0:
                     build_log += f".{extra_args}"
                     failed_log += f".{extra_args}"
+                    build_stamp += f".{extra_args}"
                     target_suffix = f"_{extra_args}"
                 # yapf: disable
                 f.write(
@@ -61,6 +72,7 @@ def mass_compile_targets(targets: List[BuildTarget], clean: bool, dry_run: bool,
 all: {target_filename}{target_suffix}_binary
 {target_filename}{target_suffix}_binary:
 	@rm -f "{build_log}" || true
+	@touch "{build_stamp}"
 	@echo "Compiling QMK Firmware for target: '{keyboard_name}:{keymap_name}'..." >>"{build_log}"
 	{' '.join(command)} \\
 		>>"{build_log}" 2>&1 \\
@@ -68,11 +80,15 @@ all: {target_filename}{target_suffix}_binary
 	@{{ grep '\\[ERRORS\\]' "{build_log}" >/dev/null 2>&1 && printf "Build %-64s \\e[1;31m[ERRORS]\\e[0m\\n" "{keyboard_name}:{keymap_name}" ; }} \\
 		|| {{ grep '\\[WARNINGS\\]' "{build_log}" >/dev/null 2>&1 && printf "Build %-64s \\e[1;33m[WARNINGS]\\e[0m\\n" "{keyboard_name}:{keymap_name}" ; }} \\
 		|| printf "Build %-64s \\e[1;32m[OK]\\e[0m\\n" "{keyboard_name}:{keymap_name}"
-	@rm -f "{build_log}" || true
 """# noqa
                 )
                 # yapf: enable
 
+                if cache_key:
+                    f.write(build_cache.store_recipe(cache_key, target_filename, build_log, failed_log, build_stamp))
+
+                f.write(f'\t@rm -f "{build_log}" "{build_stamp}" || true\n')
+
                 if no_temp:
                     # yapf: disable
                     f.write(
@@ -107,6 +123,7 @@ all: {target_filename}{target_suffix}_binary
     help=  # noqa: `format-python` and `pytest` don't agree here.
     "Filter the list of keyboards based on the supplied value in rules.mk. Matches info.json structure, and accepts the formats 'features.rgblight=true' or 'exists(matrix_pins.direct)'. May be passed multiple times, all filters need to match. Value may include wildcards such as '*' and '?'."  # noqa: `format-python` and `pytest` don't agree here.
 )
+@cli.argument('--cache', arg_only=True, action='store_true', help="Reuse firmware from previous builds whose sources, keymap, build environment and toolchain are unchanged.")
 @cli.argument('-km', '--keymap', type=str, default='default', help="The keymap name to build. Default is 'default'.")
 @cli.argument('-e', '--env', arg_only=True, action='append', default=[], help="Set a variable to be passed to make. May be passed multiple times.")
 @cli.subcommand('Compile QMK Firmware for all keyboards.', hidden=False if cli.config.user.developer else True)
@@ -123,4 +140,4 @@ def mass_compile(cli):
     else:
         targets = search_keymap_targets([('all', cli.config.mass_compile.keymap)], cli.args.filter)
 
-    return mass_compile_targets(targets, cli.args.clean, cli.args.dry_run, cli.args.no_temp, cli.config.mass_compile.parallel, **build_environment(cli.args.env))
+    return mass_compile_targets(targets, cli.args.clean, cli.args.dry_run, cli.args.no_temp, cli.config.mass_compile.parallel, cli.args.cache, **build_environment(cli.args.env))
@@ -1,11 +1,42 @@
 """This script tests QGF functionality.
 """
+import hashlib
+import json
 from io import BytesIO
+from pathlib import Path
+from qmk.constants import BUILD_DIR
 from qmk.path import normpath
 from qmk.painter import generate_subs, render_header, render_source, valid_formats
+import qmk.painter
+import qmk.painter_qgf
 from milc import cli
 from PIL import Image
 
+# Converted images are cached here, keyed on the input image, the conversion options, and the converter itself
+CACHE_PATH = Path(BUILD_DIR) / 'painter_cache'
+
+
+def _cache_key(cli):
+    h = hashlib.sha256()
+    h.update(cli.args.input.read_bytes())
+    h.update(json.dumps([cli.args.format, cli.args.no_rle, cli.args.no_deltas]).encode())
+    for module in [qmk.painter, qmk.painter_qgf]:
+        h.update(Path(module.__file__).read_bytes())
+    return h.hexdigest()
+
+
+def _print_report(metadata):
+    """Prints the size of each frame, as well as how many pixels the firmware needs to decode to render it.
+    """
+    size = metadata[0]
+    frames = metadata[1:]
+    cli.log.info('Image size: %dx%d, %d frame(s)', size['width'], size['height'], len(frames))
+    for idx, frame in enumerate(frames):
+        compression = 'rle' if frame['compression'] else 'raw'
+        kind = 'delta' if frame['delta'] else 'full'
+        cli.log.info('Frame %3d: %5s %3s, %6d bytes, %6d pixels decoded, %5dms', idx, kind, compression, frame['size'], frame['pixels'], frame['delay'])
+    cli.log.info('Total: %d bytes of frame data, %d pixels decoded per loop', sum(f['size'] for f in frames), sum(f['pixels'] for f in frames))
+
 
 @cli.argument('-v', '--verbose', arg_only=True, action='store_true', help='Turns on verbose output.')
 @cli.argument('-i', '--input', required=True, help='Specify input graphic file.')
@@ -14,6 +45,8 @@ from PIL import Image
 @cli.argument('-r', '--no-rle', arg_only=True, action='store_true', help='Disables the use of RLE when encoding images.')
 @cli.argument('-d', '--no-deltas', arg_only=True, action='store_true', help='Disables the use of delta frames when encoding animations.')
 @cli.argument('-w', '--raw', arg_only=True, action='store_true', help='Writes out the QGF file as raw data instead of c/h combo.')
+@cli.argument('--report', arg_only=True, action='store_true', help='Prints the size and decode cost of each frame.')
+@cli.argument('--no-cache', arg_only=True, action='store_true', help='Always convert the input, ignoring previously cached conversions.')
 @cli.subcommand('Converts an input image to something QMK understands')
 def painter_convert_graphics(cli):
     """Converts an image file to a format that Quantum Painter understands.
@@ -44,14 +77,31 @@ def painter_convert_graphics(cli):
     # Work out the encoding parameters
     format = valid_formats[cli.args.format]
 
-    # Load the input image
-    input_img = Image.open(cli.args.input)
+    # Reuse an earlier conversion if nothing has changed
+    cache_key = None if cli.args.no_cache else _cache_key(cli)
+    if cache_key:
+        cache_file = CACHE_PATH / f'{cache_key}.qgf'
+        cache_metadata_file = CACHE_PATH / f'{cache_key}.json'
+    if cache_key and cache_file.exists() and cache_metadata_file.exists():
+        out_bytes = cache_file.read_bytes()
+        metadata = json.loads(cache_metadata_file.read_text(encoding='utf-8'))
+    else:
+        # Load the input image
+        input_img = Image.open(cli.args.input)
+
+        # Convert the image to QGF using PIL
+        out_data = BytesIO()
+        metadata = []
+        input_img.save(out_data, "QGF", use_deltas=(not cli.args.no_deltas), use_rle=(not cli.args.no_rle), qmk_format=format, verbose=cli.args.verbose, metadata=metadata)
+        out_bytes = out_data.getvalue()
+
+        if cache_key:
+            CACHE_PATH.mkdir(parents=True, exist_ok=True)
+            cache_file.write_bytes(out_bytes)
+            cache_metadata_file.write_text(json.dumps(metadata), encoding='utf-8')
 
-    # Convert the image to QGF using PIL
-    out_data = BytesIO()
-    metadata = []
-    input_img.save(out_data, "QGF", use_deltas=(not cli.args.no_deltas), use_rle=(not cli.args.no_rle), qmk_format=format, verbose=cli.args.verbose, metadata=metadata)
-    out_bytes = out_data.getvalue()
+    if cli.args.report:
+        _print_report(metadata)
 
     if cli.args.raw:
         raw_file = cli.args.output / f"{cli.args.input.stem}.qgf"
@@ -2,20 +2,26 @@
 """
 import re
 import os
+import json
+import hashlib
+import logging
 from pathlib import Path
 import jsonschema
 from dotty_dict import dotty
 
 from milc import cli
 
-from qmk.constants import COL_LETTERS, ROW_LETTERS, CHIBIOS_PROCESSORS, LUFA_PROCESSORS, VUSB_PROCESSORS, JOYSTICK_AXES
+from qmk.constants import COL_LETTERS, ROW_LETTERS, CHIBIOS_PROCESSORS, LUFA_PROCESSORS, VUSB_PROCESSORS, JOYSTICK_AXES, BUILD_DIR
 from qmk.c_parse import find_layouts, parse_config_h_file, find_led_config
 from qmk.json_schema import deep_update, json_load, validate
-from qmk.keyboard import config_h, rules_mk
+from qmk.keyboard import config_h, rules_mk, resolve_keyboard
 from qmk.commands import parse_configurator_json
 from qmk.makefile import parse_rules_mk_file
 from qmk.math import compute
-from qmk.util import maybe_exit, truthy
+from qmk.util import maybe_exit, truthy, parallel_map
+
+# Resolved info.json data is cached here, keyed on the state of every file that went into it
+INFO_CACHE_PATH = Path(BUILD_DIR) / 'info_cache'
 
 true_values = ['1', 'on', 'yes']
 false_values = ['0', 'off', 'no']
@@ -213,8 +219,50 @@ def _validate(keyboard, info_data):
         maybe_exit(1)
 
 
+def _info_cache_inputs(keyboard):
+    """Returns a digest of the stat() results of every file which can influence the info.json for a keyboard.
+    """
+    search_dirs = [Path('data/mappings'), Path('data/schemas'), Path(__file__).parent]
+    for kb in {keyboard, resolve_keyboard(keyboard)}:
+        cur_dir = Path('keyboards')
+        for dir in Path(kb).parts:
+            cur_dir = cur_dir / dir
+            search_dirs.append(cur_dir)
+
+    inputs = [os.environ.get('SKIP_SCHEMA_VALIDATION', '')]
+    for search_dir in sorted(set(search_dirs)):
+        with os.scandir(search_dir) as entries:
+            for entry in sorted(entries, key=lambda e: e.name):
+                if entry.is_file():
+                    stat = entry.stat()
+                    inputs.append(f'{entry.path}:{stat.st_mtime_ns}:{stat.st_size}')
+
+    return hashlib.sha1('\n'.join(inputs).encode()).hexdigest()
+
+
+class _LogCapture(logging.Handler):
+    """Records the warnings and errors logged while resolving info.json, so they can be replayed from the cache.
+    """
+    def __init__(self):
+        super().__init__(logging.WARNING)
+        self.records = []
+
+    def emit(self, record):
+        self.records.append([record.levelno, record.getMessage()])
+
+
+def _info_cache_file(keyboard, force_layout):
+    name = keyboard.replace('/', '_')
+    if force_layout:
+        name += f'@{force_layout}'
+    return INFO_CACHE_PATH / f'{name}.json'
+
+
 def info_json(keyboard, force_layout=None):
     """Generate the info.json data for a specific keyboard.
+
+    Results are cached on disk and only regenerated when one of the files they were built from changes. Set the
+    environment variable `SKIP_INFO_CACHE` to bypass the cache.
     """
     cur_dir = Path('keyboards')
     root_rules_mk = parse_rules_mk_file(cur_dir / keyboard / 'rules.mk')
@@ -222,6 +270,60 @@ def info_json(keyboard, force_layout=None):
     if 'DEFAULT_FOLDER' in root_rules_mk:
         keyboard = root_rules_mk['DEFAULT_FOLDER']
 
+    if truthy(os.environ.get('SKIP_INFO_CACHE'), False):
+        return _info_json(keyboard, force_layout)
+
+    cache_file = _info_cache_file(keyboard, force_layout)
+    try:
+        inputs = _info_cache_inputs(keyboard)
+    except OSError:
+        return _info_json(keyboard, force_layout)
+
+    if cache_file.exists():
+        try:
+            cached = json.loads(cache_file.read_text(encoding='utf-8'))
+            if cached.get('inputs') == inputs:
+                for level, message in cached.get('log', []):
+                    cli.log.log(level, message)
+                return cached['info']
+        except (OSError, ValueError):
+            pass
+
+    capture = _LogCapture()
+    cli.log.addHandler(capture)
+    try:
+        info_data = _info_json(keyboard, force_layout)
+    finally:
+        cli.log.removeHandler(capture)
+
+    # Anything that failed to parse needs to report its errors again next time around
+    if not info_data['parse_errors']:
+        try:
+            INFO_CACHE_PATH.mkdir(parents=True, exist_ok=True)
+            tmp_file = cache_file.with_suffix(f'.{os.getpid()}.tmp')
+            tmp_file.write_text(json.dumps({'inputs': inputs, 'info': info_data, 'log': capture.records}, separators=(',', ':')), encoding='utf-8')
+            tmp_file.replace(cache_file)
+        except (OSError, TypeError, ValueError):
+            pass
+
+    return info_data
+
+
+def _info_json_item(keyboard):
+    return keyboard, info_json(keyboard)
+
+
+def info_json_bulk(keyboards):
+    """Generate the info.json data for many keyboards, in parallel where possible.
+
+    Returns a dictionary of keyboard name to info.json data.
+    """
+    return dict(parallel_map(_info_json_item, list(keyboards)))
+
+
+def _info_json(keyboard, force_layout=None):
+    """Resolve the info.json data for a specific keyboard, bypassing the cache.
+    """
     info_data = {
         'keyboard_name': str(keyboard),
         'keyboard_folder': str(keyboard),
@@ -3,6 +3,7 @@
 import datetime
 import math
 import re
+from itertools import groupby
 from pathlib import Path
 from string import Template
 from PIL import Image, ImageOps
@@ -323,6 +324,37 @@ def rgb_to565(r, g, b):
     return [msb, lsb]
 
 
+# Per-channel contributions to each byte of rgb_to565(), for use with bytes.translate()
+_rgb565_msb_r = bytes(rgb_to565(v, 0, 0)[0] for v in range(256))
+_rgb565_msb_g = bytes(rgb_to565(0, v, 0)[0] for v in range(256))
+_rgb565_lsb_g = bytes(rgb_to565(0, v, 0)[1] for v in range(256))
+_rgb565_lsb_b = bytes(rgb_to565(0, 0, v)[1] for v in range(256))
+
+
+def _or_bytes(*planes):
+    """Bitwise-ORs equally sized byte strings together.
+    """
+    value = 0
+    for plane in planes:
+        value |= int.from_bytes(plane, 'big')
+    return value.to_bytes(len(planes[0]), 'big')
+
+
+def _pack_pixels(values, bits_per_pixel, expected_byte_count):
+    """Packs per-pixel values into bytes, first pixel in the least significant bits.
+
+    Works a whole plane of pixels at a time -- each pixel position within a byte is shifted into place with a lookup
+    table, then all the positions are merged with a single wide OR.
+    """
+    pixels_per_byte = 8 // bits_per_pixel
+    values = bytes(values).ljust(expected_byte_count * pixels_per_byte, b'\0')
+    planes = []
+    for n in range(pixels_per_byte):
+        shift_table = bytes((v << (n * bits_per_pixel)) & 0xFF for v in range(256))
+        planes.append(values[n::pixels_per_byte].translate(shift_table))
+    return _or_bytes(*planes)
+
+
 def convert_image_bytes(im, format):
     """Convert the supplied image to the equivalent bytes required by the QMK firmware.
     """
@@ -342,25 +374,17 @@ def convert_image_bytes(im, format):
     if image_format == 'IMAGE_FORMAT_GRAYSCALE':
         # Take the red channel
         image_bytes = im.tobytes("raw", "R")
-        image_bytes_len = len(image_bytes)
 
         # No palette
         palette = None
 
-        bytearray = []
-        for x in range(expected_byte_count):
-            byte = 0
-            for n in range(pixels_per_byte):
-                byte_offset = x * pixels_per_byte + n
-                if byte_offset < image_bytes_len:
-                    # If mono, each input byte is a grayscale [0,255] pixel -- rescale to the range we want then pack together
-                    byte = byte | (rescale_byte(image_bytes[byte_offset], ncolors - 1) << int(n * shifter))
-            bytearray.append(byte)
+        # If mono, each input byte is a grayscale [0,255] pixel -- rescale to the range we want then pack together
+        rescale_table = bytes(rescale_byte(v, ncolors - 1) for v in range(256))
+        image_data = _pack_pixels(image_bytes.translate(rescale_table), shifter, expected_byte_count)
 
     elif image_format == 'IMAGE_FORMAT_PALETTE':
         # Convert each pixel to the palette bytes
         image_bytes = im.tobytes("raw", "P")
-        image_bytes_len = len(image_bytes)
 
         # Export the palette
         palette = []
@@ -368,15 +392,9 @@ def convert_image_bytes(im, format):
         for n in range(0, ncolors * 3, 3):
             palette.append((pal[n + 0], pal[n + 1], pal[n + 2]))
 
-        bytearray = []
-        for x in range(expected_byte_count):
-            byte = 0
-            for n in range(pixels_per_byte):
-                byte_offset = x * pixels_per_byte + n
-                if byte_offset < image_bytes_len:
-                    # If color, each input byte is the index into the color palette -- pack them together
-                    byte = byte | ((image_bytes[byte_offset] & (ncolors - 1)) << int(n * shifter))
-            bytearray.append(byte)
+        # If color, each input byte is the index into the color palette -- pack them together
+        mask_table = bytes(v & (ncolors - 1) for v in range(256))
+        image_data = _pack_pixels(image_bytes.translate(mask_table), shifter, expected_byte_count)
 
     if image_format == 'IMAGE_FORMAT_RGB565':
         # Take the red, green, and blue channels
@@ -387,70 +405,65 @@ def convert_image_bytes(im, format):
         # No palette
         palette = None
 
-        bytearray = [byte for r, g, b in zip(red, green, blue) for byte in rgb_to565(r, g, b)]
+        # Work out the high and low bytes of every pixel at once, then interleave them
+        image_data = bytearray(2 * len(red))
+        image_data[0::2] = _or_bytes(red.translate(_rgb565_msb_r), green.translate(_rgb565_msb_g))
+        image_data[1::2] = _or_bytes(green.translate(_rgb565_lsb_g), blue.translate(_rgb565_lsb_b))
 
     if image_format == 'IMAGE_FORMAT_RGB888':
-        # Take the red, green, and blue channels
-        red = im.tobytes("raw", "R")
-        green = im.tobytes("raw", "G")
-        blue = im.tobytes("raw", "B")
-
         # No palette
         palette = None
 
-        bytearray = [byte for r, g, b in zip(red, green, blue) for byte in (r, g, b)]
+        # Take the red, green, and blue channels, already interleaved
+        image_data = im.tobytes("raw", "RGB")
 
-    if len(bytearray) != expected_byte_count:
-        raise Exception(f"Wrong byte count, was {len(bytearray)}, expected {expected_byte_count}")
+    image_data = list(image_data)
+    if len(image_data) != expected_byte_count:
+        raise Exception(f"Wrong byte count, was {len(image_data)}, expected {expected_byte_count}")
 
-    return (palette, bytearray)
+    return (palette, image_data)
 
 
 def compress_bytes_qmk_rle(bytearray):
-    debug_dump = False
+    """Compresses the supplied bytes using QMK's RLE scheme.
+
+    Runs of 2-127 identical bytes are emitted as `count, value`, anything else as `127 + count` followed by up to 128
+    literal bytes. The input is processed a run at a time rather than byte by byte.
+    """
     output = []
-    temp = []
-    repeat = False
-
-    def append_byte(c):
-        if debug_dump:
-            print('Appending byte:', '0x{0:02X}'.format(int(c)), '=', c)
-        output.append(c)
-
-    def append_range(r):
-        append_byte(127 + len(r))
-        if debug_dump:
-            print('Appending {0} byte(s):'.format(len(r)), '[', ', '.join(['{0:02X}'.format(e) for e in r]), ']')
-        output.extend(r)
-
-    for n in range(0, len(bytearray) + 1):
-        end = True if n == len(bytearray) else False
-        if not end:
-            c = bytearray[n]
-            temp.append(c)
-            if len(temp) <= 1:
+    literal = []
+    trailing_marker = len(bytearray) == 0
+
+    def append_literal():
+        output.append(127 + len(literal))
+        output.extend(literal)
+        literal.clear()
+
+    for value, run in groupby(bytearray):
+        count = sum(1 for _ in run)
+        while count > 0:
+            trailing_marker = False
+            if count == 1 or len(literal) == 127:
+                # Lone bytes, as well as the first byte of a run which would fill the literal block, are literals
+                literal.append(value)
+                count -= 1
+                if len(literal) == 128:
+                    append_literal()
+                    trailing_marker = True
                 continue
 
-        if debug_dump:
-            print('Temp buffer state {0:3d} bytes:'.format(len(temp)), '[', ', '.join(['{0:02X}'.format(e) for e in temp]), ']')
-
-        if repeat:
-            if temp[-1] != temp[-2]:
-                repeat = False
-            if not repeat or len(temp) == 128 or end:
-                append_byte(len(temp) if end else len(temp) - 1)
-                append_byte(temp[0])
-                temp = [temp[-1]]
-                repeat = False
-        else:
-            if len(temp) >= 2 and temp[-1] == temp[-2]:
-                repeat = True
-                if len(temp) > 2:
-                    append_range(temp[0:(len(temp) - 2)])
-                    temp = [temp[-1], temp[-1]]
-                continue
-            if len(temp) == 128 or end:
-                append_range(temp)
-                temp = []
-                repeat = False
+            if len(literal) > 0:
+                append_literal()
+
+            # Repeats are capped at 127 bytes, anything left over starts afresh
+            repeat = min(count, 127)
+            output.extend([repeat, value])
+            count -= repeat
+
+    # Retain the empty literal marker emitted historically after a full literal block ends the data
+    if len(literal) > 0:
+        append_literal()
+    elif trailing_marker:
+        output.append(127)
+
     return output
@@ -11,6 +11,7 @@ from types import FunctionType
 from PIL import Image, ImageFile, ImageChops
 from PIL._binary import o8, o16le as o16, o32le as o32
 import qmk.painter
+from qmk.util import parallel_map
 
 
 def o24(i):
@@ -326,14 +327,14 @@ def _compress_image(frame, last_frame, *, use_rle, use_deltas, format_, **_kwarg
     }
 
 
-# Helper function to save each frame to the output file
-def _write_frame(idx, frame, last_frame, *, fp, frame_offsets, metadata, **kwargs):
-    # Not an argument of the function as it would then not be part of kwargs
-    # This would cause an issue with `_compress_image(**kwargs)` missing an argument
-    format_ = kwargs["format_"]
+# Helper function to compress a frame, tagged with its index as frames may be processed out of order
+def _compress_frame(item, **kwargs):
+    idx, (frame, last_frame) = item
+    return idx, _compress_image(frame, last_frame, **kwargs)
+
 
-    # (potentially) Apply RLE and/or delta, and work out output image's information
-    outputs = _compress_image(frame, last_frame, **kwargs)
+# Helper function to save each frame to the output file
+def _write_frame(idx, frame, outputs, *, fp, frame_offsets, metadata, format_):
     bbox = outputs["bbox"]
     graphic_data = outputs["graphic_data"]
     image_data = outputs["image_data"]
@@ -384,6 +385,12 @@ def _write_frame(idx, frame, last_frame, *, fp, frame_offsets, metadata, **kwarg
             delta_descriptor.right,
             delta_descriptor.bottom,
         ]})
+    # Keep track of the work the firmware has to do to render this frame
+    if frame_metadata["delta"]:
+        frame_metadata["pixels"] = (delta_descriptor.right - delta_descriptor.left + 1) * (delta_descriptor.bottom - delta_descriptor.top + 1)
+    else:
+        frame_metadata["pixels"] = frame.width * frame.height
+    frame_metadata["size"] = len(image_data)
     metadata.append(frame_metadata)
 
     # Write out the data for this frame to the output
@@ -412,9 +419,10 @@ def _save(im, fp, _filename):
     append_images = list(encoderinfo.get("append_images", []))
     for_all_frames = functools.partial(_for_all_frames, images=[im, *append_images])
 
-    # Collect all the frame sizes
-    frame_sizes = []
-    for_all_frames(lambda _idx, frame, _last_frame: frame_sizes.append(frame.size))
+    # Collect all the frames, alongside the frame preceding each one
+    frames = []
+    for_all_frames(lambda _idx, frame, last_frame: frames.append((frame, last_frame)))
+    frame_sizes = [frame.size for frame, _ in frames]
 
     # Make sure all frames are the same size
     if len(set(frame_sizes)) != 1:
@@ -436,9 +444,15 @@ def _save(im, fp, _filename):
     vprint(f'{"Frame offsets block":26s} {fp.tell():5d}d / {fp.tell():04X}h')
     frame_offsets.write(fp)
 
+    # Compress all of the frames up front -- each one only depends on the input frames, so animations can be processed
+    # in parallel
+    compress_frame = functools.partial(_compress_frame, format_=encoderinfo["qmk_format"], use_deltas=encoderinfo.get("use_deltas", True), use_rle=encoderinfo.get("use_rle", True))
+    frame_items = list(enumerate(frames))
+    outputs = dict(parallel_map(compress_frame, frame_items) if len(frame_items) > 1 else map(compress_frame, frame_items))
+
     # Iterate over each if the input frames, writing it to the output in the process
-    write_frame = functools.partial(_write_frame, format_=encoderinfo["qmk_format"], fp=fp, use_deltas=encoderinfo.get("use_deltas", True), use_rle=encoderinfo.get("use_rle", True), frame_offsets=frame_offsets, metadata=metadata)
-    for_all_frames(write_frame)
+    for idx, (frame, _) in enumerate(frames):
+        _write_frame(idx, frame, outputs[idx], format_=encoderinfo["qmk_format"], fp=fp, frame_offsets=frame_offsets, metadata=metadata)
 
     # Go back and update the graphics descriptor now that we can determine the final file size
     graphics_descriptor.total_file_size = fp.tell()
@@ -0,0 +1,38 @@
+import subprocess
+
+import qmk.build_cache
+
+TARGET = 'handwired_pytest_basic_default'
+
+
+def _build(monkeypatch, tmp_path, log):
+    """Runs a fake build printing `log`, followed by the cache store recipe, returning whether the firmware was stored.
+    """
+    monkeypatch.setattr(qmk.build_cache, 'QMK_FIRMWARE', str(tmp_path))
+    monkeypatch.setattr(qmk.build_cache, 'CACHE_DIR', tmp_path / 'cache')
+
+    build_log = tmp_path / 'build.log'
+    build_stamp = tmp_path / 'build.stamp'
+    makefile = tmp_path / 'build.mk'
+    makefile.write_text(f"""\
+all:
+	@touch "{build_stamp}"
+	@echo "{log}" >"{build_log}"
+	@echo firmware >"{tmp_path}/{TARGET}.hex"
+{qmk.build_cache.store_recipe('key', TARGET, build_log, tmp_path / 'failed.log', build_stamp)}""")
+    subprocess.run(['make', '-f', makefile, 'all'], check=True, capture_output=True)
+
+    return qmk.build_cache.restore('key', TARGET)
+
+
+def test_store_clean_build(monkeypatch, tmp_path):
+    assert _build(monkeypatch, tmp_path, 'Compiling... [OK]')
+
+
+def test_store_skips_warnings(monkeypatch, tmp_path):
+    # A cache hit would hide the warnings, so the next run has to build it again
+    assert not _build(monkeypatch, tmp_path, 'Compiling... [WARNINGS]')
+
+
+def test_store_skips_errors(monkeypatch, tmp_path):
+    assert not _build(monkeypatch, tmp_path, 'Compiling... [ERRORS]')
@@ -404,3 +404,14 @@ def test_find_multiple_conditions():
     assert len(ws2812_pin_values) > 0
     for s in ws2812_pin_values:
         assert '=D3' in s
+
+
+def test_mass_compile_cache():
+    # The first build stores the firmware in the cache (if it wasn't already there), so the second has to restore it
+    result = check_subcommand('mass-compile', '--cache', 'handwired/pytest/basic:default')
+    check_returncode(result)
+    assert '[ERRORS]' not in result.stdout
+
+    result = check_subcommand('mass-compile', '--cache', 'handwired/pytest/basic:default')
+    check_returncode(result)
+    assert '[CACHED]' in result.stdout
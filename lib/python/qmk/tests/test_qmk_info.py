@@ -0,0 +1,103 @@
+import logging
+import os
+
+from milc import cli
+
+import qmk.info
+
+KEYBOARD = 'handwired/pytest/basic'
+
+
+class _Recorder(logging.Handler):
+    def __init__(self):
+        super().__init__(logging.WARNING)
+        self.messages = []
+
+    def emit(self, record):
+        self.messages.append(record.getMessage())
+
+
+def _fake_info_json(calls):
+    def fake(keyboard, force_layout=None):
+        calls.append(keyboard)
+        cli.log.warning('%s: something looks odd', keyboard)
+        return {'keyboard_folder': keyboard, 'parse_errors': [], 'parse_warnings': ['something looks odd']}
+
+    return fake
+
+
+def test_info_cache_inputs_stable():
+    assert qmk.info._info_cache_inputs(KEYBOARD) == qmk.info._info_cache_inputs(KEYBOARD)
+
+
+def test_info_cache_inputs_change_with_keyboard_files():
+    info_file = f'keyboards/{KEYBOARD}/keyboard.json'
+    stat = os.stat(info_file)
+    before = qmk.info._info_cache_inputs(KEYBOARD)
+    try:
+        os.utime(info_file, ns=(stat.st_atime_ns, stat.st_mtime_ns + 1000000000))
+        assert qmk.info._info_cache_inputs(KEYBOARD) != before
+    finally:
+        os.utime(info_file, ns=(stat.st_atime_ns, stat.st_mtime_ns))
+    assert qmk.info._info_cache_inputs(KEYBOARD) == before
+
+
+def test_info_cache_inputs_change_with_schema_validation(monkeypatch):
+    monkeypatch.delenv('SKIP_SCHEMA_VALIDATION', raising=False)
+    before = qmk.info._info_cache_inputs(KEYBOARD)
+    monkeypatch.setenv('SKIP_SCHEMA_VALIDATION', '1')
+    assert qmk.info._info_cache_inputs(KEYBOARD) != before
+
+
+def test_info_cache_file_includes_layout():
+    assert qmk.info._info_cache_file(KEYBOARD, None) != qmk.info._info_cache_file(KEYBOARD, 'LAYOUT_ortho_1x1')
+
+
+def test_info_cache_hit_and_invalidation(monkeypatch, tmp_path):
+    calls = []
+    monkeypatch.delenv('SKIP_INFO_CACHE', raising=False)
+    monkeypatch.setattr(qmk.info, 'INFO_CACHE_PATH', tmp_path)
+    monkeypatch.setattr(qmk.info, '_info_json', _fake_info_json(calls))
+
+    first = qmk.info.info_json(KEYBOARD)
+    second = qmk.info.info_json(KEYBOARD)
+    assert first == second
+    assert len(calls) == 1
+
+    monkeypatch.setattr(qmk.info, '_info_cache_inputs', lambda keyboard: 'changed')
+    qmk.info.info_json(KEYBOARD)
+    assert len(calls) == 2
+
+
+def test_info_cache_replays_warnings(monkeypatch, tmp_path):
+    calls = []
+    monkeypatch.delenv('SKIP_INFO_CACHE', raising=False)
+    monkeypatch.setattr(qmk.info, 'INFO_CACHE_PATH', tmp_path)
+    monkeypatch.setattr(qmk.info, '_info_json', _fake_info_json(calls))
+
+    recorder = _Recorder()
+    cli.log.addHandler(recorder)
+    try:
+        qmk.info.info_json(KEYBOARD)
+        qmk.info.info_json(KEYBOARD)
+    finally:
+        cli.log.removeHandler(recorder)
+
+    assert len(calls) == 1
+    assert recorder.messages == [f'{KEYBOARD}: something looks odd'] * 2
+
+
+def test_info_cache_skips_parse_errors(monkeypatch, tmp_path):
+    calls = []
+
+    def failing(keyboard, force_layout=None):
+        calls.append(keyboard)
+        return {'keyboard_folder': keyboard, 'parse_errors': ['broken'], 'parse_warnings': []}
+
+    monkeypatch.delenv('SKIP_INFO_CACHE', raising=False)
+    monkeypatch.setattr(qmk.info, 'INFO_CACHE_PATH', tmp_path)
+    monkeypatch.setattr(qmk.info, '_info_json', failing)
+
+    qmk.info.info_json(KEYBOARD)
+    qmk.info.info_json(KEYBOARD)
+    assert len(calls) == 2
@@ -108,6 +108,24 @@ static const I2CConfig i2cconfig = {
 #endif
 };
 
+#ifdef I2C_ASYNC_ENABLE
+#    ifndef I2C_ASYNC_QUEUE_SIZE
+#        define I2C_ASYNC_QUEUE_SIZE 8
+#    endif
+#    ifndef I2C_ASYNC_THREAD_STACK_SIZE
+#        define I2C_ASYNC_THREAD_STACK_SIZE 512
+#    endif
+
+// The blocking API may be called from the main loop while the worker thread
+// is running a queued transaction, so every transfer takes the bus lock.
+static MUTEX_DECL(i2c_mutex);
+#    define i2c_lock() chMtxLock(&i2c_mutex)
+#    define i2c_unlock() chMtxUnlock(&i2c_mutex)
+#else
+#    define i2c_lock()
+#    define i2c_unlock()
+#endif
+
 /**
  * @brief Handles any I2C error condition by stopping the I2C peripheral and
  * aborting any ongoing transactions. Furthermore ChibiOS status codes are
@@ -150,18 +168,25 @@ __attribute__((weak)) void i2c_init(void) {
 }
 
 i2c_status_t i2c_transmit(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_lock();
     i2cStart(&I2C_DRIVER, &i2cconfig);
     msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (address >> 1), data, length, 0, 0, TIME_MS2I(timeout));
-    return i2c_epilogue(status);
+    i2c_status_t result = i2c_epilogue(status);
+    i2c_unlock();
+    return result;
 }
 
 i2c_status_t i2c_receive(uint8_t address, uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_lock();
     i2cStart(&I2C_DRIVER, &i2cconfig);
     msg_t status = i2cMasterReceiveTimeout(&I2C_DRIVER, (address >> 1), data, length, TIME_MS2I(timeout));
-    return i2c_epilogue(status);
+    i2c_status_t result = i2c_epilogue(status);
+    i2c_unlock();
+    return result;
 }
 
 i2c_status_t i2c_write_register(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_lock();
     i2cStart(&I2C_DRIVER, &i2cconfig);
 
     uint8_t complete_packet[length + 1];
@@ -171,10 +196,13 @@ i2c_status_t i2c_write_register(uint8_t devaddr, uint8_t regaddr, const uint8_t*
     complete_packet[0] = regaddr;
 
     msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (devaddr >> 1), complete_packet, length + 1, 0, 0, TIME_MS2I(timeout));
-    return i2c_epilogue(status);
+    i2c_status_t result = i2c_epilogue(status);
+    i2c_unlock();
+    return result;
 }
 
 i2c_status_t i2c_write_register16(uint8_t devaddr, uint16_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_lock();
     i2cStart(&I2C_DRIVER, &i2cconfig);
 
     uint8_t complete_packet[length + 2];
@@ -185,20 +213,28 @@ i2c_status_t i2c_write_register16(uint8_t devaddr, uint16_t regaddr, const uint8
     complete_packet[1] = regaddr & 0xFF;
 
     msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (devaddr >> 1), complete_packet, length + 2, 0, 0, TIME_MS2I(timeout));
-    return i2c_epilogue(status);
+    i2c_status_t result = i2c_epilogue(status);
+    i2c_unlock();
+    return result;
 }
 
 i2c_status_t i2c_read_register(uint8_t devaddr, uint8_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_lock();
     i2cStart(&I2C_DRIVER, &i2cconfig);
     msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (devaddr >> 1), &regaddr, 1, data, length, TIME_MS2I(timeout));
-    return i2c_epilogue(status);
+    i2c_status_t result = i2c_epilogue(status);
+    i2c_unlock();
+    return result;
 }
 
 i2c_status_t i2c_read_register16(uint8_t devaddr, uint16_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_lock();
     i2cStart(&I2C_DRIVER, &i2cconfig);
     uint8_t register_packet[2] = {regaddr >> 8, regaddr & 0xFF};
     msg_t   status             = i2cMasterTransmitTimeout(&I2C_DRIVER, (devaddr >> 1), register_packet, 2, data, length, TIME_MS2I(timeout));
-    return i2c_epilogue(status);
+    i2c_status_t result = i2c_epilogue(status);
+    i2c_unlock();
+    return result;
 }
 
 __attribute__((weak)) i2c_status_t i2c_ping_address(uint8_t address, uint16_t timeout) {
@@ -207,4 +243,108 @@ __attribute__((weak)) i2c_status_t i2c_ping_address(uint8_t address, uint16_t ti
     // This approach may produce false negative results for I2C devices that do not respond to a register 0 read request.
     uint8_t data = 0;
     return i2c_read_register(address, 0, &data, sizeof(data), timeout);
-}
\ No newline at end of file
+}
+#ifdef I2C_ASYNC_ENABLE
+typedef struct {
+    const i2c_transaction_t*  transactions;
+    uint8_t                   count;
+    i2c_completion_callback_t callback;
+    void*                     cb_arg;
+} i2c_job_t;
+
+typedef struct {
+    i2c_job_t jobs[I2C_ASYNC_QUEUE_SIZE];
+    uint8_t   head;
+    uint8_t   count;
+} i2c_job_queue_t;
+
+// Index 0 is I2C_PRIORITY_NORMAL, index 1 is I2C_PRIORITY_HIGH
+static i2c_job_queue_t i2c_queues[2];
+static SEMAPHORE_DECL(i2c_jobs_pending, 0);
+static volatile bool i2c_job_running = false;
+
+static i2c_status_t i2c_run_transaction(const i2c_transaction_t* transaction) {
+    switch (transaction->type) {
+        case I2C_TRANSACTION_TRANSMIT:
+            return i2c_transmit(transaction->address, transaction->data, transaction->length, transaction->timeout);
+        case I2C_TRANSACTION_RECEIVE:
+            return i2c_receive(transaction->address, transaction->data, transaction->length, transaction->timeout);
+        case I2C_TRANSACTION_WRITE_REGISTER:
+            return i2c_write_register(transaction->address, transaction->regaddr, transaction->data, transaction->length, transaction->timeout);
+        case I2C_TRANSACTION_READ_REGISTER:
+            return i2c_read_register(transaction->address, transaction->regaddr, transaction->data, transaction->length, transaction->timeout);
+    }
+    return I2C_STATUS_ERROR;
+}
+
+static THD_WORKING_AREA(waI2CThread, I2C_ASYNC_THREAD_STACK_SIZE);
+static THD_FUNCTION(I2CThread, arg) {
+    (void)arg;
+    chRegSetThreadName("i2c_async");
+
+    while (true) {
+        chSemWait(&i2c_jobs_pending);
+
+        // High priority jobs always go first, even if normal ones were queued earlier
+        chSysLock();
+        i2c_job_queue_t* queue = i2c_queues[I2C_PRIORITY_HIGH].count ? &i2c_queues[I2C_PRIORITY_HIGH] : &i2c_queues[I2C_PRIORITY_NORMAL];
+        i2c_job_t        job   = queue->jobs[queue->head];
+        queue->head            = (queue->head + 1) % I2C_ASYNC_QUEUE_SIZE;
+        queue->count--;
+        i2c_job_running = true;
+        chSysUnlock();
+
+        // The transfers themselves are interrupt/DMA driven, this thread sleeps until each one completes
+        i2c_status_t status = I2C_STATUS_SUCCESS;
+        for (uint8_t i = 0; i < job.count && status == I2C_STATUS_SUCCESS; i++) {
+            status = i2c_run_transaction(&job.transactions[i]);
+        }
+
+        if (job.callback) {
+            job.callback(status, job.cb_arg);
+        }
+        i2c_job_running = false;
+    }
+}
+
+/**
+ * @brief Queues a list of transactions to be run in order by the I2C thread.
+ *
+ * The list is aborted at the first failing transaction. The transaction list
+ * and its buffers must stay valid until the callback has been called, which
+ * happens from the I2C thread.
+ *
+ * @return false if the queue for this priority is full
+ */
+bool i2c_submit(const i2c_transaction_t* transactions, uint8_t count, i2c_priority_t priority, i2c_completion_callback_t callback, void* cb_arg) {
+    static bool thread_started = false;
+    if (!thread_started) {
+        thread_started = true;
+        // Just above the main loop, so queued jobs start as soon as the bus is free
+        chThdCreateStatic(waI2CThread, sizeof(waI2CThread), NORMALPRIO + 1, I2CThread, NULL);
+    }
+
+    i2c_job_queue_t* queue = &i2c_queues[priority == I2C_PRIORITY_HIGH ? I2C_PRIORITY_HIGH : I2C_PRIORITY_NORMAL];
+
+    chSysLock();
+    if (queue->count >= I2C_ASYNC_QUEUE_SIZE) {
+        chSysUnlock();
+        return false;
+    }
+    queue->jobs[(queue->head + queue->count) % I2C_ASYNC_QUEUE_SIZE] = (i2c_job_t){
+        .transactions = transactions,
+        .count        = count,
+        .callback     = callback,
+        .cb_arg       = cb_arg,
+    };
+    queue->count++;
+    chSemSignalI(&i2c_jobs_pending);
+    chSchRescheduleS();
+    chSysUnlock();
+    return true;
+}
+
+bool i2c_is_busy(void) {
+    return i2c_job_running || i2c_queues[I2C_PRIORITY_HIGH].count || i2c_queues[I2C_PRIORITY_NORMAL].count;
+}
+#endif
@@ -47,3 +47,33 @@ i2c_status_t i2c_write_register16(uint8_t devaddr, uint16_t regaddr, const uint8
 i2c_status_t i2c_read_register(uint8_t devaddr, uint8_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout);
 i2c_status_t i2c_read_register16(uint8_t devaddr, uint16_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout);
 i2c_status_t i2c_ping_address(uint8_t address, uint16_t timeout);
+
+#ifdef I2C_ASYNC_ENABLE
+#    include <stdbool.h>
+
+typedef enum {
+    I2C_TRANSACTION_TRANSMIT,
+    I2C_TRANSACTION_RECEIVE,
+    I2C_TRANSACTION_WRITE_REGISTER,
+    I2C_TRANSACTION_READ_REGISTER,
+} i2c_transaction_type_t;
+
+typedef enum {
+    I2C_PRIORITY_NORMAL, // Bulk transfers, e.g. LED drivers and displays
+    I2C_PRIORITY_HIGH,   // Latency sensitive devices, e.g. matrix expanders and pointing devices
+} i2c_priority_t;
+
+typedef struct {
+    i2c_transaction_type_t type;
+    uint8_t                address;
+    uint8_t                regaddr; // Only used by register transactions
+    uint8_t*               data;
+    uint16_t               length;
+    uint16_t               timeout;
+} i2c_transaction_t;
+
+typedef void (*i2c_completion_callback_t)(i2c_status_t status, void* cb_arg);
+
+bool i2c_submit(const i2c_transaction_t* transactions, uint8_t count, i2c_priority_t priority, i2c_completion_callback_t callback, void* cb_arg);
+bool i2c_is_busy(void);
+#endif
@@ -113,59 +113,93 @@
 #define RESET_SIZE (1000 * WS2812_TRST_US / (2 * WS2812_TIMING))
 #define PREAMBLE_SIZE 4
 
-static uint8_t txbuf[PREAMBLE_SIZE + DATA_SIZE + RESET_SIZE] = {0};
+ws2812_led_t ws2812_leds[WS2812_LED_COUNT];
+
+#define TXBUF_SIZE (PREAMBLE_SIZE + DATA_SIZE + RESET_SIZE)
+
+// Double buffering only makes sense when the transfer runs in the background
+#if defined(WS2812_SPI_DOUBLE_BUFFER) && !defined(WS2812_SPI_USE_CIRCULAR_BUFFER) && !defined(WS2812_SPI_SYNC)
+#    define TXBUF_COUNT 2
+#else
+#    define TXBUF_COUNT 1
+#endif
+
+static uint8_t txbufs[TXBUF_COUNT][TXBUF_SIZE] = {0};
+#if TXBUF_COUNT > 1
+static uint8_t txbuf_index = 0;
+
+// How long to wait for the previous frame before dropping the next one
+#    ifndef WS2812_SPI_TIMEOUT
+#        define WS2812_SPI_TIMEOUT 100
+#    endif
+
+// Signalled from the SPI end callback, so a transfer is never restarted while one is in flight
+static binary_semaphore_t transfer_done;
+
+static void ws2812_spi_end_cb(SPIDriver* spip) {
+    (void)spip;
+    osalSysLockFromISR();
+    chBSemSignalI(&transfer_done);
+    osalSysUnlockFromISR();
+}
+#    define WS2812_SPI_END_CB ws2812_spi_end_cb
+#else
+#    define WS2812_SPI_END_CB NULL
+#endif
 
 /*
  * As the trick here is to use the SPI to send a huge pattern of 0 and 1 to
- * the ws2812b protocol, we use this helper function to translate bytes into
- * 0s and 1s for the LED (with the appropriate timing).
+ * the ws2812b protocol, each data bit is sent as a nibble: 0b1110 for a 1
+ * and 0b1000 for a 0, most significant bit first. This table holds the two
+ * SPI bytes for every nibble of LED data, so a byte is encoded with two loads.
  */
-static uint8_t get_protocol_eq(uint8_t data, int pos) {
-    uint8_t eq = 0;
-    if (data & (1 << (2 * (3 - pos))))
-        eq = 0b1110;
-    else
-        eq = 0b1000;
-    if (data & (2 << (2 * (3 - pos))))
-        eq += 0b11100000;
-    else
-        eq += 0b10000000;
-    return eq;
+#define WS2812_SPI_BIT(data, bit) (((data) & (1 << (bit))) ? 0b1110 : 0b1000)
+#define WS2812_SPI_PAIR(data, bit) ((WS2812_SPI_BIT(data, bit) << 4) | WS2812_SPI_BIT(data, (bit) - 1))
+#define WS2812_SPI_NIBBLE(data) \
+    { WS2812_SPI_PAIR(data, 3), WS2812_SPI_PAIR(data, 1) }
+
+static const uint8_t protocol_lut[16][2] = {
+    WS2812_SPI_NIBBLE(0x0), WS2812_SPI_NIBBLE(0x1), WS2812_SPI_NIBBLE(0x2), WS2812_SPI_NIBBLE(0x3),
+    WS2812_SPI_NIBBLE(0x4), WS2812_SPI_NIBBLE(0x5), WS2812_SPI_NIBBLE(0x6), WS2812_SPI_NIBBLE(0x7),
+    WS2812_SPI_NIBBLE(0x8), WS2812_SPI_NIBBLE(0x9), WS2812_SPI_NIBBLE(0xA), WS2812_SPI_NIBBLE(0xB),
+    WS2812_SPI_NIBBLE(0xC), WS2812_SPI_NIBBLE(0xD), WS2812_SPI_NIBBLE(0xE), WS2812_SPI_NIBBLE(0xF),
+};
+
+static inline uint8_t* encode_byte(uint8_t* tx, uint8_t data) {
+    const uint8_t* hi = protocol_lut[data >> 4];
+    const uint8_t* lo = protocol_lut[data & 0x0F];
+
+    tx[0] = hi[0];
+    tx[1] = hi[1];
+    tx[2] = lo[0];
+    tx[3] = lo[1];
+    return tx + BYTES_FOR_LED_BYTE;
 }
 
-static void set_led_color_rgb(ws2812_led_t color, int pos) {
-    uint8_t* tx_start = &txbuf[PREAMBLE_SIZE];
+static void set_leds_color_rgb(uint8_t* txbuf) {
+    uint8_t* tx = &txbuf[PREAMBLE_SIZE];
 
+    for (int i = 0; i < WS2812_LED_COUNT; i++) {
+        ws2812_led_t color = ws2812_leds[i];
 #if (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_GRB)
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.g, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.r, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.b, j);
+        tx = encode_byte(tx, color.g);
+        tx = encode_byte(tx, color.r);
+        tx = encode_byte(tx, color.b);
 #elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_RGB)
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.r, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.g, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.b, j);
+        tx = encode_byte(tx, color.r);
+        tx = encode_byte(tx, color.g);
+        tx = encode_byte(tx, color.b);
 #elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_BGR)
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.b, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.g, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.r, j);
+        tx = encode_byte(tx, color.b);
+        tx = encode_byte(tx, color.g);
+        tx = encode_byte(tx, color.r);
 #endif
 #ifdef WS2812_RGBW
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 3 + j] = get_protocol_eq(color.w, j);
+        tx = encode_byte(tx, color.w);
 #endif
+    }
 }
 
-ws2812_led_t ws2812_leds[WS2812_LED_COUNT];
-
 void ws2812_init(void) {
     palSetLineMode(WS2812_DI_PIN, WS2812_MOSI_OUTPUT_MODE);
 
@@ -180,7 +214,7 @@ void ws2812_init(void) {
 #    if SPI_SUPPORTS_CIRCULAR == TRUE
         WS2812_SPI_BUFFER_MODE,
 #    endif
-        NULL, // end_cb
+        WS2812_SPI_END_CB, // end_cb
         PAL_PORT(WS2812_DI_PIN),
         PAL_PAD(WS2812_DI_PIN),
 #    if defined(WB32F3G71xx) || defined(WB32FQ95xx)
@@ -199,8 +233,8 @@ void ws2812_init(void) {
 #    if SPI_SUPPORTS_SLAVE_MODE == TRUE
         false,
 #    endif
-        NULL, // data_cb
-        NULL, // error_cb
+        WS2812_SPI_END_CB, // data_cb
+        NULL,              // error_cb
         PAL_PORT(WS2812_DI_PIN),
         PAL_PAD(WS2812_DI_PIN),
 #    if defined(AT32F415)
@@ -216,11 +250,15 @@ void ws2812_init(void) {
 #endif
     };
 
+#if TXBUF_COUNT > 1
+    chBSemObjectInit(&transfer_done, false);
+#endif
+
     spiAcquireBus(&WS2812_SPI_DRIVER);     /* Acquire ownership of the bus.    */
     spiStart(&WS2812_SPI_DRIVER, &spicfg); /* Setup transfer parameters.       */
     spiSelect(&WS2812_SPI_DRIVER);         /* Slave Select assertion.          */
 #ifdef WS2812_SPI_USE_CIRCULAR_BUFFER
-    spiStartSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf), txbuf);
+    spiStartSend(&WS2812_SPI_DRIVER, TXBUF_SIZE, txbufs[0]);
 #endif
 }
 
@@ -240,17 +278,32 @@ void ws2812_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
 }
 
 void ws2812_flush(void) {
-    for (int i = 0; i < WS2812_LED_COUNT; i++) {
-        set_led_color_rgb(ws2812_leds[i], i);
-    }
+#if TXBUF_COUNT > 1
+    // Encode into the idle buffer while the previous frame may still be in flight
+    uint8_t* txbuf = txbufs[txbuf_index];
+#else
+    uint8_t* txbuf = txbufs[0];
+#endif
+
+    set_leds_color_rgb(txbuf);
 
     // Send async - each led takes ~0.03ms, 50 leds ~1.5ms, animations flushing faster than send will cause issues.
     // Instead spiSend can be used to send synchronously (or the thread logic can be added back).
 #ifndef WS2812_SPI_USE_CIRCULAR_BUFFER
 #    ifdef WS2812_SPI_SYNC
-    spiSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf), txbuf);
+    spiSend(&WS2812_SPI_DRIVER, TXBUF_SIZE, txbuf);
 #    else
-    spiStartSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf), txbuf);
+#        if TXBUF_COUNT > 1
+    // Only the encoding overlaps the previous transfer, the SPI itself can't be restarted until it is done
+    if (chBSemWaitTimeout(&transfer_done, TIME_MS2I(WS2812_SPI_TIMEOUT)) != MSG_OK) {
+        // Still sending from the other buffer, so this one stays idle for the next frame
+        return;
+    }
+#        endif
+    spiStartSend(&WS2812_SPI_DRIVER, TXBUF_SIZE, txbuf);
+#        if TXBUF_COUNT > 1
+    txbuf_index ^= 1;
+#        endif
 #    endif
 #endif
 }
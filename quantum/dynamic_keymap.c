@@ -14,6 +14,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <string.h>
 #include "dynamic_keymap.h"
 #include "keymap_introspection.h"
 #include "action.h"
@@ -21,6 +22,11 @@
 #include "progmem.h"
 #include "send_string.h"
 #include "keycodes.h"
+#include "util.h"
+
+#ifdef DYNAMIC_KEYMAP_BULK_ENABLE
+#    include "crc.h"
+#endif
 
 #ifdef VIA_ENABLE
 #    include "via.h"
@@ -63,6 +69,10 @@
 #    error DYNAMIC_KEYMAP_EEPROM_MAX_ADDR must be less than 65536
 #endif
 
+// Size of the keymap and encoder map regions, in bytes
+#define DYNAMIC_KEYMAP_KEYMAP_SIZE (DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2)
+#define DYNAMIC_KEYMAP_ENCODER_SIZE (DYNAMIC_KEYMAP_LAYER_COUNT * NUM_ENCODERS * 2 * 2)
+
 // If DYNAMIC_KEYMAP_EEPROM_ADDR not explicitly defined in config.h,
 #ifndef DYNAMIC_KEYMAP_EEPROM_ADDR
 #    define DYNAMIC_KEYMAP_EEPROM_ADDR DYNAMIC_KEYMAP_EEPROM_START
@@ -70,13 +80,13 @@
 
 // Dynamic encoders starts after dynamic keymaps
 #ifndef DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR
-#    define DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR (DYNAMIC_KEYMAP_EEPROM_ADDR + (DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2))
+#    define DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR (DYNAMIC_KEYMAP_EEPROM_ADDR + DYNAMIC_KEYMAP_KEYMAP_SIZE)
 #endif
 
 // Dynamic macro starts after dynamic encoders, but only when using ENCODER_MAP
 #ifdef ENCODER_MAP_ENABLE
 #    ifndef DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR
-#        define DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR (DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR + (DYNAMIC_KEYMAP_LAYER_COUNT * NUM_ENCODERS * 2 * 2))
+#        define DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR (DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR + DYNAMIC_KEYMAP_ENCODER_SIZE)
 #    endif // DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR
 #else      // ENCODER_MAP_ENABLE
 #    ifndef DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR
@@ -110,53 +120,121 @@ void *dynamic_keymap_key_to_eeprom_address(uint8_t layer, uint8_t row, uint8_t c
     return ((void *)DYNAMIC_KEYMAP_EEPROM_ADDR) + (layer * MATRIX_ROWS * MATRIX_COLS * 2) + (row * MATRIX_COLS * 2) + (column * 2);
 }
 
+#ifdef ENCODER_MAP_ENABLE
+void *dynamic_keymap_encoder_to_eeprom_address(uint8_t layer, uint8_t encoder_id) {
+    return ((void *)DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR) + (layer * NUM_ENCODERS * 2 * 2) + (encoder_id * 2 * 2);
+}
+#endif // ENCODER_MAP_ENABLE
+
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE_ENABLE
+// Byte for byte copies of the keymap and encoder map EEPROM regions, loaded on first use
+// and written through on every update, so key lookups never touch the EEPROM driver.
+static uint8_t dynamic_keymap_cache[DYNAMIC_KEYMAP_KEYMAP_SIZE];
+#    ifdef ENCODER_MAP_ENABLE
+static uint8_t dynamic_keymap_encoder_cache[DYNAMIC_KEYMAP_ENCODER_SIZE];
+#    endif // ENCODER_MAP_ENABLE
+static bool dynamic_keymap_cache_loaded = false;
+
+static void dynamic_keymap_cache_load(void) {
+    eeprom_read_block(dynamic_keymap_cache, (void *)DYNAMIC_KEYMAP_EEPROM_ADDR, sizeof(dynamic_keymap_cache));
+#    ifdef ENCODER_MAP_ENABLE
+    eeprom_read_block(dynamic_keymap_encoder_cache, (void *)DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR, sizeof(dynamic_keymap_encoder_cache));
+#    endif // ENCODER_MAP_ENABLE
+    dynamic_keymap_cache_loaded = true;
+}
+
+void dynamic_keymap_cache_invalidate(void) {
+    dynamic_keymap_cache_loaded = false;
+}
+#endif // DYNAMIC_KEYMAP_RAM_CACHE_ENABLE
+
+uint16_t dynamic_keymap_get_ram_cache_size(void) {
+#if defined(DYNAMIC_KEYMAP_RAM_CACHE_ENABLE) && defined(ENCODER_MAP_ENABLE)
+    return sizeof(dynamic_keymap_cache) + sizeof(dynamic_keymap_encoder_cache);
+#elif defined(DYNAMIC_KEYMAP_RAM_CACHE_ENABLE)
+    return sizeof(dynamic_keymap_cache);
+#else
+    return 0;
+#endif
+}
+
+static void dynamic_keymap_read(void *address, uint8_t *data, uint16_t size) {
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE_ENABLE
+    if (!dynamic_keymap_cache_loaded) {
+        dynamic_keymap_cache_load();
+    }
+#    ifdef ENCODER_MAP_ENABLE
+    if (address >= (void *)DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR && address < (void *)DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR + DYNAMIC_KEYMAP_ENCODER_SIZE) {
+        memcpy(data, dynamic_keymap_encoder_cache + (address - (void *)DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR), size);
+        return;
+    }
+#    endif // ENCODER_MAP_ENABLE
+    memcpy(data, dynamic_keymap_cache + (address - (void *)DYNAMIC_KEYMAP_EEPROM_ADDR), size);
+#else
+    eeprom_read_block(data, address, size);
+#endif // DYNAMIC_KEYMAP_RAM_CACHE_ENABLE
+}
+
+static void dynamic_keymap_write(void *address, const uint8_t *data, uint16_t size) {
+    eeprom_update_block(data, address, size);
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE_ENABLE
+    if (!dynamic_keymap_cache_loaded) {
+        return;
+    }
+#    ifdef ENCODER_MAP_ENABLE
+    if (address >= (void *)DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR && address < (void *)DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR + DYNAMIC_KEYMAP_ENCODER_SIZE) {
+        memcpy(dynamic_keymap_encoder_cache + (address - (void *)DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR), data, size);
+        return;
+    }
+#    endif // ENCODER_MAP_ENABLE
+    memcpy(dynamic_keymap_cache + (address - (void *)DYNAMIC_KEYMAP_EEPROM_ADDR), data, size);
+#endif // DYNAMIC_KEYMAP_RAM_CACHE_ENABLE
+}
+
 uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column) {
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return KC_NO;
-    void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
+    uint8_t data[2];
+    dynamic_keymap_read(dynamic_keymap_key_to_eeprom_address(layer, row, column), data, sizeof(data));
     // Big endian, so we can read/write EEPROM directly from host if we want
-    uint16_t keycode = eeprom_read_byte(address) << 8;
-    keycode |= eeprom_read_byte(address + 1);
-    return keycode;
+    return (uint16_t)data[0] << 8 | data[1];
 }
 
 void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint16_t keycode) {
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return;
-    void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
-    eeprom_update_byte(address, (uint8_t)(keycode >> 8));
-    eeprom_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+    uint8_t data[2] = {(uint8_t)(keycode >> 8), (uint8_t)(keycode & 0xFF)};
+    dynamic_keymap_write(dynamic_keymap_key_to_eeprom_address(layer, row, column), data, sizeof(data));
 }
 
 #ifdef ENCODER_MAP_ENABLE
-void *dynamic_keymap_encoder_to_eeprom_address(uint8_t layer, uint8_t encoder_id) {
-    return ((void *)DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR) + (layer * NUM_ENCODERS * 2 * 2) + (encoder_id * 2 * 2);
-}
-
 uint16_t dynamic_keymap_get_encoder(uint8_t layer, uint8_t encoder_id, bool clockwise) {
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || encoder_id >= NUM_ENCODERS) return KC_NO;
-    void *address = dynamic_keymap_encoder_to_eeprom_address(layer, encoder_id);
+    uint8_t data[2];
+    dynamic_keymap_read(dynamic_keymap_encoder_to_eeprom_address(layer, encoder_id) + (clockwise ? 0 : 2), data, sizeof(data));
     // Big endian, so we can read/write EEPROM directly from host if we want
-    uint16_t keycode = ((uint16_t)eeprom_read_byte(address + (clockwise ? 0 : 2))) << 8;
-    keycode |= eeprom_read_byte(address + (clockwise ? 0 : 2) + 1);
-    return keycode;
+    return (uint16_t)data[0] << 8 | data[1];
 }
 
 void dynamic_keymap_set_encoder(uint8_t layer, uint8_t encoder_id, bool clockwise, uint16_t keycode) {
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || encoder_id >= NUM_ENCODERS) return;
-    void *address = dynamic_keymap_encoder_to_eeprom_address(layer, encoder_id);
     // Big endian, so we can read/write EEPROM directly from host if we want
-    eeprom_update_byte(address + (clockwise ? 0 : 2), (uint8_t)(keycode >> 8));
-    eeprom_update_byte(address + (clockwise ? 0 : 2) + 1, (uint8_t)(keycode & 0xFF));
+    uint8_t data[2] = {(uint8_t)(keycode >> 8), (uint8_t)(keycode & 0xFF)};
+    dynamic_keymap_write(dynamic_keymap_encoder_to_eeprom_address(layer, encoder_id) + (clockwise ? 0 : 2), data, sizeof(data));
 }
 #endif // ENCODER_MAP_ENABLE
 
 void dynamic_keymap_reset(void) {
-    // Reset the keymaps in EEPROM to what is in flash.
+    // Reset the keymaps in EEPROM to what is in flash, a row at a time.
+    uint8_t row_data[MATRIX_COLS * 2];
     for (int layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
         for (int row = 0; row < MATRIX_ROWS; row++) {
             for (int column = 0; column < MATRIX_COLS; column++) {
-                dynamic_keymap_set_keycode(layer, row, column, keycode_at_keymap_location_raw(layer, row, column));
+                // Big endian, so we can read/write EEPROM directly from host if we want
+                uint16_t keycode         = keycode_at_keymap_location_raw(layer, row, column);
+                row_data[column * 2]     = (uint8_t)(keycode >> 8);
+                row_data[column * 2 + 1] = (uint8_t)(keycode & 0xFF);
             }
+            dynamic_keymap_write(dynamic_keymap_key_to_eeprom_address(layer, row, 0), row_data, sizeof(row_data));
         }
 #ifdef ENCODER_MAP_ENABLE
         for (int encoder = 0; encoder < NUM_ENCODERS; encoder++) {
@@ -167,31 +245,27 @@ void dynamic_keymap_reset(void) {
     }
 }
 
+// Clamps a host supplied (offset, size) window to a region of `region_size` bytes,
+// returning how many bytes of the window are backed by EEPROM.
+static uint16_t dynamic_keymap_clamp_window(uint16_t offset, uint16_t size, uint16_t region_size) {
+    if (offset >= region_size) {
+        return 0;
+    }
+    return ((uint32_t)offset + size > region_size) ? region_size - offset : size;
+}
+
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   source                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
-    uint8_t *target                     = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < dynamic_keymap_eeprom_size) {
-            *target = eeprom_read_byte(source);
-        } else {
-            *target = 0x00;
-        }
-        source++;
-        target++;
+    uint16_t valid = dynamic_keymap_clamp_window(offset, size, DYNAMIC_KEYMAP_KEYMAP_SIZE);
+    if (valid) {
+        dynamic_keymap_read((void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset), data, valid);
     }
+    memset(data + valid, 0x00, size - valid);
 }
 
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   target                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
-    uint8_t *source                     = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < dynamic_keymap_eeprom_size) {
-            eeprom_update_byte(target, *source);
-        }
-        source++;
-        target++;
+    uint16_t valid = dynamic_keymap_clamp_window(offset, size, DYNAMIC_KEYMAP_KEYMAP_SIZE);
+    if (valid) {
+        dynamic_keymap_write((void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset), data, valid);
     }
 }
 
@@ -219,122 +293,329 @@ uint16_t dynamic_keymap_macro_get_buffer_size(void) {
     return DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE;
 }
 
-void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   source = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
-    uint8_t *target = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
-            *target = eeprom_read_byte(source);
-        } else {
-            *target = 0x00;
+// Offset of the start of each macro within the macro buffer, built on first use so
+// sending a macro doesn't need to scan the EEPROM for the preceding ones.
+static uint16_t dynamic_keymap_macro_offsets[DYNAMIC_KEYMAP_MACRO_COUNT];
+static bool     dynamic_keymap_macro_offsets_valid = false;
+
+// Size of the RAM window used when scanning and sending macros
+#define DYNAMIC_KEYMAP_MACRO_CHUNK_SIZE 32
+
+static void dynamic_keymap_macro_build_offsets(void) {
+    uint8_t chunk[DYNAMIC_KEYMAP_MACRO_CHUNK_SIZE];
+    uint8_t id = 0;
+
+    dynamic_keymap_macro_offsets[id++] = 0;
+    for (uint16_t offset = 0; offset < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE && id < DYNAMIC_KEYMAP_MACRO_COUNT; offset += sizeof(chunk)) {
+        uint16_t len = MIN(sizeof(chunk), (uint16_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - offset));
+        eeprom_read_block(chunk, (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset), len);
+        for (uint16_t i = 0; i < len && id < DYNAMIC_KEYMAP_MACRO_COUNT; i++) {
+            if (chunk[i] == 0) {
+                dynamic_keymap_macro_offsets[id++] = offset + i + 1;
+            }
         }
-        source++;
-        target++;
     }
+    // Any macros past the end of the buffer are empty
+    while (id < DYNAMIC_KEYMAP_MACRO_COUNT) {
+        dynamic_keymap_macro_offsets[id++] = DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE;
+    }
+    dynamic_keymap_macro_offsets_valid = true;
+}
+
+void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
+    uint16_t valid = dynamic_keymap_clamp_window(offset, size, DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE);
+    eeprom_read_block(data, (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset), valid);
+    memset(data + valid, 0x00, size - valid);
 }
 
 void dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   target = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
-    uint8_t *source = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
-            eeprom_update_byte(target, *source);
-        }
-        source++;
-        target++;
+    uint16_t valid = dynamic_keymap_clamp_window(offset, size, DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE);
+    if (valid) {
+        eeprom_update_block(data, (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset), valid);
     }
+    dynamic_keymap_macro_offsets_valid = false;
 }
 
 void dynamic_keymap_macro_reset(void) {
-    void *p   = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR);
-    void *end = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE);
-    while (p != end) {
-        eeprom_update_byte(p, 0);
-        ++p;
+    // Clear in chunks rather than byte by byte, so the EEPROM driver can batch the writes.
+    static const uint8_t zeros[32] = {0};
+    for (uint16_t offset = 0; offset < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE; offset += sizeof(zeros)) {
+        eeprom_update_block(zeros, (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset), MIN(sizeof(zeros), (uint16_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - offset)));
     }
+    dynamic_keymap_macro_offsets_valid = false;
 }
 
-void dynamic_keymap_macro_send(uint8_t id) {
-    if (id >= DYNAMIC_KEYMAP_MACRO_COUNT) {
-        return;
+#ifdef DYNAMIC_KEYMAP_BULK_ENABLE
+// Packets are collected a window at a time, so each window reaches the EEPROM
+// driver as one block write.
+static uint8_t  bulk_window[DYNAMIC_KEYMAP_BULK_WINDOW * DYNAMIC_KEYMAP_BULK_PACKET_SIZE];
+static uint16_t bulk_window_used = 0;
+static uint16_t bulk_base        = 0; // EEPROM address of the region
+static uint16_t bulk_offset      = 0; // Where the current window starts within the region
+static uint16_t bulk_remaining   = 0; // Bytes still to be received
+static uint16_t bulk_sequence    = 0;
+static uint8_t  bulk_region      = 0;
+static uint8_t  bulk_valid_flag  = 0; // Held back last byte of the macro buffer
+static bool     bulk_active      = false;
+
+#    define DYNAMIC_KEYMAP_MACRO_VALID_FLAG ((void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - 1))
+
+dynamic_keymap_bulk_status_t dynamic_keymap_bulk_begin(uint8_t region, uint16_t offset, uint16_t size) {
+    bulk_active = false;
+
+    uint16_t region_size;
+    switch (region) {
+        case DYNAMIC_KEYMAP_BULK_KEYMAP:
+            region_size = DYNAMIC_KEYMAP_KEYMAP_SIZE;
+            bulk_base   = DYNAMIC_KEYMAP_EEPROM_ADDR;
+            break;
+        case DYNAMIC_KEYMAP_BULK_MACROS:
+            region_size = DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE;
+            bulk_base   = DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR;
+            break;
+        default:
+            return DYNAMIC_KEYMAP_BULK_ERROR_RANGE;
+    }
+    if (size == 0 || dynamic_keymap_clamp_window(offset, size, region_size) != size) {
+        return DYNAMIC_KEYMAP_BULK_ERROR_RANGE;
     }
 
-    // Check the last byte of the buffer.
-    // If it's not zero, then we are in the middle
-    // of buffer writing, possibly an aborted buffer
-    // write. So do nothing.
-    void *p = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - 1);
-    if (eeprom_read_byte(p) != 0) {
-        return;
+    if (region == DYNAMIC_KEYMAP_BULK_MACROS) {
+        // Stop macros being sent from a half written buffer, see dynamic_keymap.h
+        eeprom_update_byte(DYNAMIC_KEYMAP_MACRO_VALID_FLAG, 0xFF);
+        dynamic_keymap_macro_offsets_valid = false;
     }
 
-    // Skip N null characters
-    // p will then point to the Nth macro
-    p         = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR);
-    void *end = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE);
-    while (id > 0) {
-        // If we are past the end of the buffer, then there is
-        // no Nth macro in the buffer.
-        if (p == end) {
-            return;
-        }
-        if (eeprom_read_byte(p) == 0) {
-            --id;
+    bulk_window_used = 0;
+    bulk_offset      = offset;
+    bulk_remaining   = size;
+    bulk_sequence    = 0;
+    bulk_region      = region;
+    bulk_valid_flag  = 0;
+    bulk_active      = true;
+    return DYNAMIC_KEYMAP_BULK_OK;
+}
+
+dynamic_keymap_bulk_status_t dynamic_keymap_bulk_write(uint16_t sequence, uint8_t crc, const uint8_t *data) {
+    if (!bulk_active || bulk_remaining == 0) {
+        return DYNAMIC_KEYMAP_BULK_ERROR_STATE;
+    }
+    if (sequence != bulk_sequence) {
+        return DYNAMIC_KEYMAP_BULK_ERROR_SEQUENCE;
+    }
+    uint8_t length = MIN(DYNAMIC_KEYMAP_BULK_PACKET_SIZE, bulk_remaining);
+    if (crc8(data, length) != crc) {
+        return DYNAMIC_KEYMAP_BULK_ERROR_CRC;
+    }
+
+    memcpy(bulk_window + bulk_window_used, data, length);
+    bulk_window_used += length;
+    bulk_remaining -= length;
+    bulk_sequence++;
+
+    if (bulk_window_used < sizeof(bulk_window) && bulk_remaining > 0) {
+        return DYNAMIC_KEYMAP_BULK_PENDING;
+    }
+    if (bulk_region == DYNAMIC_KEYMAP_BULK_KEYMAP) {
+        dynamic_keymap_write((void *)(bulk_base + bulk_offset), bulk_window, bulk_window_used);
+    } else {
+        uint16_t block = bulk_window_used;
+        if (bulk_offset + block == DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
+            // Leave the valid flag for dynamic_keymap_bulk_commit()
+            bulk_valid_flag = bulk_window[--block];
         }
-        ++p;
+        eeprom_update_block(bulk_window, (void *)(bulk_base + bulk_offset), block);
     }
+    bulk_offset += bulk_window_used;
+    bulk_window_used = 0;
+    return DYNAMIC_KEYMAP_BULK_OK;
+}
 
-    // Send the macro string by making a temporary string.
-    char data[8] = {0};
-    // We already checked there was a null at the end of
-    // the buffer, so this cannot go past the end
-    while (1) {
-        data[0] = eeprom_read_byte(p++);
-        data[1] = 0;
+dynamic_keymap_bulk_status_t dynamic_keymap_bulk_commit(void) {
+    if (!bulk_active || bulk_remaining > 0) {
+        return DYNAMIC_KEYMAP_BULK_ERROR_STATE;
+    }
+    if (bulk_region == DYNAMIC_KEYMAP_BULK_MACROS) {
+        // A transfer which ended on the last byte sets the flag to whatever it
+        // sent, as set_buffer would, otherwise a well formed buffer ends in a null
+        eeprom_update_byte(DYNAMIC_KEYMAP_MACRO_VALID_FLAG, bulk_offset == DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE ? bulk_valid_flag : 0);
+        dynamic_keymap_macro_offsets_valid = false;
+    }
+    bulk_active = false;
+    return DYNAMIC_KEYMAP_BULK_OK;
+}
+
+uint16_t dynamic_keymap_bulk_get_sequence(void) {
+    return bulk_sequence;
+}
+#endif // DYNAMIC_KEYMAP_BULK_ENABLE
+
+// Reads up to `size` bytes of the macro starting at `offset` into `data`, cut after
+// the last complete SS_TAP/SS_DOWN/SS_UP/SS_DELAY sequence so none are split, and
+// moves `offset` past them. Returns false once the rest of the macro has been read.
+static bool dynamic_keymap_macro_read_window(uint16_t *offset, char *data, uint16_t size) {
+    uint16_t len = MIN(size, DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - *offset);
+    eeprom_read_block(data, (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + *offset), len);
+    data[len] = 0;
+
+    uint16_t i    = 0;
+    uint16_t end  = 0;
+    bool     stop = false;
+    while (i < len) {
         // Stop at the null terminator of this macro string
-        if (data[0] == 0) {
+        if (data[i] == 0) {
+            stop = true;
             break;
         }
-        if (data[0] == SS_QMK_PREFIX) {
-            // Get the code
-            data[1] = eeprom_read_byte(p++);
+        if (data[i] == SS_QMK_PREFIX) {
+            // Sequence continues into the next window
+            if (i + 1 >= len) {
+                break;
+            }
             // Unexpected null, abort.
-            if (data[1] == 0) {
-                return;
+            if (data[i + 1] == 0) {
+                stop = true;
+                break;
             }
-            if (data[1] == SS_TAP_CODE || data[1] == SS_DOWN_CODE || data[1] == SS_UP_CODE) {
-                // Get the keycode
-                data[2] = eeprom_read_byte(p++);
+            if (data[i + 1] == SS_TAP_CODE || data[i + 1] == SS_DOWN_CODE || data[i + 1] == SS_UP_CODE) {
+                if (i + 2 >= len) {
+                    break;
+                }
                 // Unexpected null, abort.
-                if (data[2] == 0) {
-                    return;
+                if (data[i + 2] == 0) {
+                    stop = true;
+                    break;
                 }
-                // Null terminate
-                data[3] = 0;
-            } else if (data[1] == SS_DELAY_CODE) {
-                // Get the number and '|'
+                i += 3;
+            } else if (data[i + 1] == SS_DELAY_CODE) {
                 // At most this is 4 digits plus '|'
-                uint8_t i = 2;
-                while (1) {
-                    data[i] = eeprom_read_byte(p++);
-                    // Unexpected null, abort
-                    if (data[i] == 0) {
-                        return;
-                    }
-                    // Found '|', send it
-                    if (data[i] == '|') {
-                        data[i + 1] = 0;
-                        break;
-                    }
-                    // If haven't found '|' by i==6 then
-                    // number too big, abort
-                    if (i == 6) {
-                        return;
-                    }
-                    ++i;
+                uint16_t j = i + 2;
+                while (j < len && j < i + 6 && data[j] != 0 && data[j] != '|') {
+                    ++j;
+                }
+                if (j >= len) {
+                    break;
+                }
+                // Unexpected null, or number too big, abort
+                if (data[j] != '|') {
+                    stop = true;
+                    break;
+                }
+                i = j + 1;
+            } else {
+                i += 2;
+            }
+        } else {
+            ++i;
+        }
+        end = i;
+    }
+
+    data[end] = 0;
+    *offset += end;
+    // A sequence that doesn't fit in a whole window can only be corrupt data.
+    return !stop && end != 0 && *offset < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE;
+}
+
+// Check the last byte of the buffer.
+// If it's not zero, then we are in the middle
+// of buffer writing, possibly an aborted buffer
+// write. So do nothing.
+static bool dynamic_keymap_macro_is_valid(void) {
+    void *p = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - 1);
+    if (eeprom_read_byte(p) != 0) {
+        return false;
+    }
+
+    if (!dynamic_keymap_macro_offsets_valid) {
+        dynamic_keymap_macro_build_offsets();
+    }
+    return true;
+}
+
+#ifdef SEND_STRING_ASYNC_ENABLE
+// Macros are queued to send_string_async a window at a time, and the rest is
+// picked up by dynamic_keymap_macro_send_task() as the queue drains, so long
+// macros never hold up the main loop.
+#    define DYNAMIC_KEYMAP_MACRO_SEND_QUEUE_SIZE 4
+// Each window is queued with a header byte and a null terminator
+#    define DYNAMIC_KEYMAP_MACRO_SEND_WINDOW_SIZE MIN(DYNAMIC_KEYMAP_MACRO_CHUNK_SIZE, SEND_STRING_ASYNC_BUFFER_SIZE - 2)
+
+// Room for the longest sequence, SS_DELAY with four digits
+_Static_assert(DYNAMIC_KEYMAP_MACRO_SEND_WINDOW_SIZE >= 7, "SEND_STRING_ASYNC_BUFFER_SIZE is too small to send dynamic keymap macros");
+
+static char     macro_send_window[DYNAMIC_KEYMAP_MACRO_SEND_WINDOW_SIZE + 1];
+static uint16_t macro_send_offset = 0;     // Where the next window starts
+static bool     macro_send_loaded = false; // macro_send_window is waiting for room in the queue
+static bool     macro_send_more   = false; // The macro continues past macro_send_window
+static uint8_t  macro_send_queue[DYNAMIC_KEYMAP_MACRO_SEND_QUEUE_SIZE];
+static uint8_t  macro_send_queue_count = 0; // Macros waiting for the current one to finish
+
+bool dynamic_keymap_macro_send_is_pending(void) {
+    return macro_send_loaded || macro_send_more || macro_send_queue_count > 0;
+}
+
+void dynamic_keymap_macro_send_task(void) {
+    // The macro buffer was rewritten under the macro being sent
+    if (!dynamic_keymap_macro_offsets_valid) {
+        macro_send_loaded = false;
+        macro_send_more   = false;
+    }
+
+    while (true) {
+        if (!macro_send_loaded) {
+            if (!macro_send_more) {
+                if (macro_send_queue_count == 0) {
+                    return;
+                }
+                uint8_t id = macro_send_queue[0];
+                memmove(macro_send_queue, macro_send_queue + 1, --macro_send_queue_count);
+                if (!dynamic_keymap_macro_is_valid()) {
+                    continue;
+                }
+                macro_send_offset = dynamic_keymap_macro_offsets[id];
+                if (macro_send_offset >= DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
+                    continue;
                 }
             }
+            macro_send_more   = dynamic_keymap_macro_read_window(&macro_send_offset, macro_send_window, DYNAMIC_KEYMAP_MACRO_SEND_WINDOW_SIZE);
+            macro_send_loaded = true;
         }
+
+        // Wait for the queue to drain
+        if (macro_send_window[0] != 0 && !send_string_async_with_delay(macro_send_window, DYNAMIC_KEYMAP_MACRO_DELAY)) {
+            return;
+        }
+        macro_send_loaded = false;
+    }
+}
+#endif // SEND_STRING_ASYNC_ENABLE
+
+void dynamic_keymap_macro_send(uint8_t id) {
+    if (id >= DYNAMIC_KEYMAP_MACRO_COUNT) {
+        return;
+    }
+
+#ifdef SEND_STRING_ASYNC_ENABLE
+    // Sent behind anything already queued, see dynamic_keymap_macro_send_task()
+    if (macro_send_queue_count < DYNAMIC_KEYMAP_MACRO_SEND_QUEUE_SIZE) {
+        macro_send_queue[macro_send_queue_count++] = id;
+    }
+    dynamic_keymap_macro_send_task();
+#else
+    if (!dynamic_keymap_macro_is_valid()) {
+        return;
+    }
+
+    // Send the macro a window at a time.
+    // We already checked there was a null at the end of
+    // the buffer, so this cannot go past the end
+    char     data[DYNAMIC_KEYMAP_MACRO_CHUNK_SIZE + 1];
+    uint16_t offset = dynamic_keymap_macro_offsets[id];
+    bool     more   = offset < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE;
+    while (more) {
+        more = dynamic_keymap_macro_read_window(&offset, data, DYNAMIC_KEYMAP_MACRO_CHUNK_SIZE);
         send_string_with_delay(data, DYNAMIC_KEYMAP_MACRO_DELAY);
     }
+#endif
 }
@@ -27,6 +27,14 @@ uint16_t dynamic_keymap_get_encoder(uint8_t layer, uint8_t encoder_id, bool cloc
 void     dynamic_keymap_set_encoder(uint8_t layer, uint8_t encoder_id, bool clockwise, uint16_t keycode);
 #endif // ENCODER_MAP_ENABLE
 void dynamic_keymap_reset(void);
+// Number of bytes of RAM used to mirror the keymap and encoder map, 0 unless
+// DYNAMIC_KEYMAP_RAM_CACHE_ENABLE is defined
+uint16_t dynamic_keymap_get_ram_cache_size(void);
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE_ENABLE
+// Forces the RAM mirror to be reloaded from EEPROM on next use, needed only if
+// the EEPROM is written without going through the dynamic_keymap_set_* functions
+void dynamic_keymap_cache_invalidate(void);
+#endif
 // These get/set the keycodes as stored in the EEPROM buffer
 // Data is big-endian 16-bit values (the keycodes)
 // Order is by layer/row/column
@@ -61,6 +69,51 @@ void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data);
 // Note: dynamic_keymap_macro_get_count() returns the maximum that *can* be
 // stored, not the current count of macros in the buffer.
 
+#ifdef DYNAMIC_KEYMAP_BULK_ENABLE
+// Bulk transfers stream a whole region to EEPROM in fewer round trips than the
+// set_buffer functions above:
+//
+// 1. dynamic_keymap_bulk_begin() opens a transfer of `size` bytes at `offset`
+//    within a region. For the macro region, macro sending is disabled until the
+//    transfer is committed.
+// 2. The data follows in DYNAMIC_KEYMAP_BULK_PACKET_SIZE byte packets, numbered
+//    from 0, each with the crc8() of its payload. Packets are collected in RAM
+//    until DYNAMIC_KEYMAP_BULK_WINDOW of them have arrived intact, and each window
+//    is then written to EEPROM with a single block write. A packet which is out
+//    of sequence or fails its CRC is dropped, and the host goes back and resends
+//    from dynamic_keymap_bulk_get_sequence().
+// 3. dynamic_keymap_bulk_commit() checks that every byte has been received, and
+//    re-enables macro sending. The last byte of the macro buffer is held back
+//    until then, so a transfer that ends on it can't re-enable macros early.
+#    ifndef DYNAMIC_KEYMAP_BULK_WINDOW
+#        define DYNAMIC_KEYMAP_BULK_WINDOW 8
+#    endif
+// A 32 byte report, less the command id, bulk command id, sequence and CRC
+#    define DYNAMIC_KEYMAP_BULK_PACKET_SIZE 27
+// Reported to the host, bump when the bulk transfer commands change
+#    define DYNAMIC_KEYMAP_BULK_VERSION 1
+
+enum dynamic_keymap_bulk_region {
+    DYNAMIC_KEYMAP_BULK_KEYMAP = 0,
+    DYNAMIC_KEYMAP_BULK_MACROS = 1,
+};
+
+typedef enum {
+    DYNAMIC_KEYMAP_BULK_OK             = 0,
+    DYNAMIC_KEYMAP_BULK_PENDING        = 1, // Packet accepted and held in RAM until the window is full
+    DYNAMIC_KEYMAP_BULK_ERROR_RANGE    = 2, // Unknown region, or the transfer doesn't fit inside it
+    DYNAMIC_KEYMAP_BULK_ERROR_STATE    = 3, // No transfer in progress, or committed before all the data arrived
+    DYNAMIC_KEYMAP_BULK_ERROR_SEQUENCE = 4,
+    DYNAMIC_KEYMAP_BULK_ERROR_CRC      = 5,
+} dynamic_keymap_bulk_status_t;
+
+dynamic_keymap_bulk_status_t dynamic_keymap_bulk_begin(uint8_t region, uint16_t offset, uint16_t size);
+dynamic_keymap_bulk_status_t dynamic_keymap_bulk_write(uint16_t sequence, uint8_t crc, const uint8_t *data);
+dynamic_keymap_bulk_status_t dynamic_keymap_bulk_commit(void);
+// The sequence number of the next packet expected
+uint16_t dynamic_keymap_bulk_get_sequence(void);
+#endif // DYNAMIC_KEYMAP_BULK_ENABLE
+
 uint8_t  dynamic_keymap_macro_get_count(void);
 uint16_t dynamic_keymap_macro_get_buffer_size(void);
 void     dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *data);
@@ -68,3 +121,10 @@ void     dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t
 void     dynamic_keymap_macro_reset(void);
 
 void dynamic_keymap_macro_send(uint8_t id);
+
+#ifdef SEND_STRING_ASYNC_ENABLE
+// Queues the next part of the macro being sent once send_string_async has room,
+// called from send_string_async_task()
+void dynamic_keymap_macro_send_task(void);
+bool dynamic_keymap_macro_send_is_pending(void);
+#endif
@@ -56,6 +56,15 @@
 #    define QUANTUM_PAINTER_LOAD_FONTS_TO_RAM FALSE
 #endif
 
+#ifndef QUANTUM_PAINTER_FONT_ATLAS
+/**
+ * @def This controls whether fonts can have a RAM glyph atlas, loaded with \ref qp_load_font_atlas. Strings made up
+ *      entirely of atlas glyphs are drawn from RAM with a single viewport for the whole string, instead of locating and
+ *      decoding each glyph in the font data. Defaults to "off"; the atlas itself is allocated on demand.
+ */
+#    define QUANTUM_PAINTER_FONT_ATLAS FALSE
+#endif
+
 #ifndef QUANTUM_PAINTER_CONCURRENT_ANIMATIONS
 /**
  * @def This controls the maximum number of animations that Quantum Painter can play simultaneously. Increasing this
@@ -80,6 +89,24 @@
 #    define QUANTUM_PAINTER_SUPPORTS_256_PALETTE FALSE
 #endif
 
+#ifndef QUANTUM_PAINTER_DECODE_BATCH_SIZE
+/**
+ * @def This controls how many palette-based pixels are decoded at a time before being handed to the driver. Must be a
+ *      multiple of 8. Larger batches mean fewer calls into the driver, at the cost of stack space.
+ */
+#    define QUANTUM_PAINTER_DECODE_BATCH_SIZE 64
+#endif
+_Static_assert(QUANTUM_PAINTER_DECODE_BATCH_SIZE % 8 == 0, "QUANTUM_PAINTER_DECODE_BATCH_SIZE must be a multiple of 8");
+
+#ifndef QUANTUM_PAINTER_PALETTE_CACHE_SIZE
+/**
+ * @def This controls how many converted image palettes of up to 16 colors are kept in RAM, so that redrawing an image
+ *      or replaying an animation skips reading and converting the palette of each frame. Each entry requires 64 bytes
+ *      of RAM. Set to 0 to disable.
+ */
+#    define QUANTUM_PAINTER_PALETTE_CACHE_SIZE 0
+#endif
+
 #ifndef QUANTUM_PAINTER_SUPPORTS_NATIVE_COLORS
 /**
  * @def This controls whether the native color range is supported. This avoids the use of palettes but each image
@@ -440,6 +467,21 @@ void qp_stop_animation(deferred_token anim_token);
  */
 painter_font_handle_t qp_load_font_mem(const void *buffer);
 
+#if QUANTUM_PAINTER_FONT_ATLAS
+/**
+ * Decodes a set of glyphs of a font into RAM, so that strings made up only of those glyphs can be drawn in one go.
+ *
+ * @note Requires QUANTUM_PAINTER_FONT_ATLAS. Any previously loaded atlas for this font is replaced. The atlas is freed
+ *       when the font is closed.
+ *
+ * @param font[in] the handle of the font
+ * @param charset[in] a UTF-8 string of the glyphs to load, e.g. "0123456789%"
+ * @return true if the atlas was loaded
+ * @return false if a glyph could not be found or there was not enough RAM
+ */
+bool qp_load_font_atlas(painter_font_handle_t font, const char *charset);
+#endif // QUANTUM_PAINTER_FONT_ATLAS
+
 /**
  * Closes a font handle when no longer in use.
  *
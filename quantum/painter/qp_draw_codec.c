@@ -165,7 +165,92 @@ bool qp_internal_byte_appender(uint8_t byteval, void* cb_arg) {
     return true;
 }
 
-// Helper shared between image and font rendering -- uses either (qp_internal_decode_palette + qp_internal_pixel_appender) or (qp_internal_send_bytes) to send data data to the display based on the asset's native-ness
+// Hands a run of palette indices over to the driver in as few pieces as the transmit buffer allows, sending the buffer
+// whenever it fills up.
+bool qp_internal_append_indices(painter_device_t device, uint8_t *indices, uint32_t pixel_count, qp_internal_pixel_output_state_t *output_state) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+
+    uint32_t offset = 0;
+    while (offset < pixel_count) {
+        uint32_t space = output_state->max_pixels - output_state->pixel_write_pos;
+        uint32_t count = (pixel_count - offset) < space ? (pixel_count - offset) : space;
+        if (!driver->driver_vtable->append_pixels(device, qp_internal_global_pixdata_buffer, qp_internal_global_pixel_lookup_table, output_state->pixel_write_pos, count, &indices[offset])) {
+            return false;
+        }
+        output_state->pixel_write_pos += count;
+        offset += count;
+
+        // If we've hit the transmit limit, send out the entire buffer and reset the write position
+        if (output_state->pixel_write_pos == output_state->max_pixels) {
+            if (!driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, output_state->pixel_write_pos)) {
+                return false;
+            }
+            output_state->pixel_write_pos = 0;
+        }
+    }
+    return true;
+}
+
+// Unpacks whole input bytes into palette indices. Forced inline with a constant bpp at each call site, so every pixel
+// format gets its own loop with the shifts and masks resolved at compile time.
+static inline __attribute__((always_inline)) bool qp_internal_unpack_indices(uint8_t *indices, uint16_t pixel_count, const uint8_t bits_per_pixel, qp_internal_byte_input_callback input_callback, void *input_arg) {
+    const uint8_t pixel_bitmask   = (1 << bits_per_pixel) - 1;
+    const uint8_t pixels_per_byte = 8 / bits_per_pixel;
+    for (uint16_t i = 0; i < pixel_count; i += pixels_per_byte) {
+        int16_t byteval = input_callback(input_arg);
+        if (byteval < 0) {
+            return false;
+        }
+        for (uint8_t q = 0; q < pixels_per_byte; ++q) {
+            indices[i + q] = byteval & pixel_bitmask;
+            byteval >>= bits_per_pixel;
+        }
+    }
+    return true;
+}
+
+// Bulk equivalent of qp_internal_decode_palette() + qp_internal_pixel_appender(): pixels are decoded a batch at a time
+// and handed to the driver with a single append_pixels() call, instead of one indirect call per pixel.
+static bool qp_internal_decode_palette_bulk(painter_device_t device, uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_byte_input_callback input_callback, void *input_arg, qp_internal_pixel_output_state_t *output_state) {
+    // Batches are a multiple of 8 pixels, so only the last one can end part way through an input byte. The extra space
+    // absorbs the unused pixels unpacked from that byte.
+    uint8_t  indices[QUANTUM_PAINTER_DECODE_BATCH_SIZE + 8];
+    uint32_t remaining_pixels = pixel_count;
+    while (remaining_pixels > 0) {
+        uint16_t batch_pixels = remaining_pixels < QUANTUM_PAINTER_DECODE_BATCH_SIZE ? remaining_pixels : QUANTUM_PAINTER_DECODE_BATCH_SIZE;
+
+        bool ok;
+        switch (bits_per_pixel) {
+            case 1:
+                ok = qp_internal_unpack_indices(indices, batch_pixels, 1, input_callback, input_arg);
+                break;
+            case 2:
+                ok = qp_internal_unpack_indices(indices, batch_pixels, 2, input_callback, input_arg);
+                break;
+            case 4:
+                ok = qp_internal_unpack_indices(indices, batch_pixels, 4, input_callback, input_arg);
+                break;
+            case 8:
+                ok = qp_internal_unpack_indices(indices, batch_pixels, 8, input_callback, input_arg);
+                break;
+            default:
+                ok = qp_internal_unpack_indices(indices, batch_pixels, bits_per_pixel, input_callback, input_arg);
+                break;
+        }
+        if (!ok) {
+            return false;
+        }
+
+        if (!qp_internal_append_indices(device, indices, batch_pixels, output_state)) {
+            return false;
+        }
+
+        remaining_pixels -= batch_pixels;
+    }
+    return true;
+}
+
+// Helper shared between image and font rendering -- uses either (qp_internal_decode_palette_bulk) or (qp_internal_send_bytes) to send data data to the display based on the asset's native-ness
 bool qp_internal_appender(painter_device_t device, uint8_t bpp, uint32_t pixel_count, qp_internal_byte_input_callback input_callback, void* input_state) {
     painter_driver_t* driver = (painter_driver_t*)device;
 
@@ -177,7 +262,7 @@ bool qp_internal_appender(painter_device_t device, uint8_t bpp, uint32_t pixel_c
         qp_internal_pixel_output_state_t output_state = {.device = device, .pixel_write_pos = 0, .max_pixels = qp_internal_num_pixels_in_buffer(device)};
 
         // Decode the pixel data and stream to the display
-        ret = qp_internal_decode_palette(device, pixel_count, bpp, input_callback, input_state, qp_internal_global_pixel_lookup_table, qp_internal_pixel_appender, &output_state);
+        ret = qp_internal_decode_palette_bulk(device, pixel_count, bpp, input_callback, input_state, &output_state);
         // Any leftovers need transmission as well.
         if (ret && output_state.pixel_write_pos > 0) {
             ret &= driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, output_state.pixel_write_pos);
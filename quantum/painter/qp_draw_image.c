@@ -24,6 +24,68 @@ typedef struct qgf_image_handle_t {
 
 static qgf_image_handle_t image_descriptors[QUANTUM_PAINTER_NUM_IMAGES] = {0};
 
+#if QUANTUM_PAINTER_PALETTE_CACHE_SIZE > 0
+// Converted palettes of up to 16 colors, keyed by the location of the palette block in the image
+typedef struct qgf_palette_cache_entry_t {
+    painter_device_t    device;
+    qgf_image_handle_t *image;
+    int32_t             position;
+    uint8_t             bpp;
+    uint16_t            last_used;
+    qp_pixel_t          palette[16];
+} qgf_palette_cache_entry_t;
+
+static qgf_palette_cache_entry_t palette_cache[QUANTUM_PAINTER_PALETTE_CACHE_SIZE] = {0};
+static uint16_t                  palette_cache_counter                             = 0;
+
+static bool qp_drawimage_palette_cache_restore(painter_device_t device, qgf_image_handle_t *qgf_image, int32_t position, uint8_t bpp) {
+    for (int i = 0; i < QUANTUM_PAINTER_PALETTE_CACHE_SIZE; ++i) {
+        qgf_palette_cache_entry_t *entry = &palette_cache[i];
+        if (entry->device == device && entry->image == qgf_image && entry->position == position && entry->bpp == bpp) {
+            memcpy(qp_internal_global_pixel_lookup_table, entry->palette, (1u << bpp) * sizeof(qp_pixel_t));
+            entry->last_used = ++palette_cache_counter;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void qp_drawimage_palette_cache_store(painter_device_t device, qgf_image_handle_t *qgf_image, int32_t position, uint8_t bpp) {
+    if (bpp > 4) {
+        return;
+    }
+
+    // Prefer an empty slot, otherwise evict the least recently used one
+    qgf_palette_cache_entry_t *target = &palette_cache[0];
+    for (int i = 0; i < QUANTUM_PAINTER_PALETTE_CACHE_SIZE; ++i) {
+        qgf_palette_cache_entry_t *entry = &palette_cache[i];
+        if (entry->device == NULL) {
+            target = entry;
+            break;
+        }
+        if ((uint16_t)(palette_cache_counter - entry->last_used) > (uint16_t)(palette_cache_counter - target->last_used)) {
+            target = entry;
+        }
+    }
+
+    target->device    = device;
+    target->image     = qgf_image;
+    target->position  = position;
+    target->bpp       = bpp;
+    target->last_used = ++palette_cache_counter;
+    memcpy(target->palette, qp_internal_global_pixel_lookup_table, (1u << bpp) * sizeof(qp_pixel_t));
+}
+
+static void qp_drawimage_palette_cache_invalidate(qgf_image_handle_t *qgf_image) {
+    for (int i = 0; i < QUANTUM_PAINTER_PALETTE_CACHE_SIZE; ++i) {
+        if (palette_cache[i].image == qgf_image) {
+            palette_cache[i].device = NULL;
+            palette_cache[i].image  = NULL;
+        }
+    }
+}
+#endif // QUANTUM_PAINTER_PALETTE_CACHE_SIZE > 0
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Helper: load image from stream
 
@@ -97,6 +159,9 @@ bool qp_close_image(painter_image_handle_t image) {
 
     // Free up this image for use elsewhere.
     qgf_image->validate_ok = false;
+#if QUANTUM_PAINTER_PALETTE_CACHE_SIZE > 0
+    qp_drawimage_palette_cache_invalidate(qgf_image);
+#endif
     qp_stream_close(&qgf_image->stream);
     return true;
 }
@@ -160,13 +225,26 @@ static bool qp_drawimage_prepare_frame_for_stream_read(painter_device_t device,
     // Handle palette if needed
     const uint16_t palette_entries  = 1u << info->bpp;
     bool           needs_pixconvert = false;
+#if QUANTUM_PAINTER_PALETTE_CACHE_SIZE > 0
+    int32_t palette_position = -1;
+#endif
     if (info->has_palette) {
-        // Load the palette from the stream
-        if (!qp_internal_load_qgf_palette((qp_stream_t *)&qgf_image->stream, info->bpp)) {
-            return false;
+#if QUANTUM_PAINTER_PALETTE_CACHE_SIZE > 0
+        palette_position = qp_stream_tell(&qgf_image->stream);
+        if (qp_drawimage_palette_cache_restore(device, qgf_image, palette_position, info->bpp)) {
+            // Already converted, skip over the palette block
+            qp_stream_seek(&qgf_image->stream, sizeof(qgf_palette_v1_t) + palette_entries * sizeof(qgf_palette_entry_v1_t), SEEK_CUR);
+            palette_position = -1;
+        } else
+#endif
+        {
+            // Load the palette from the stream
+            if (!qp_internal_load_qgf_palette((qp_stream_t *)&qgf_image->stream, info->bpp)) {
+                return false;
+            }
+
+            needs_pixconvert = true;
         }
-
-        needs_pixconvert = true;
     } else {
         if (info->bpp <= 8) {
             // Interpolate from fg/bg
@@ -183,6 +261,12 @@ static bool qp_drawimage_prepare_frame_for_stream_read(painter_device_t device,
         }
     }
 
+#if QUANTUM_PAINTER_PALETTE_CACHE_SIZE > 0
+    if (palette_position >= 0) {
+        qp_drawimage_palette_cache_store(device, qgf_image, palette_position, info->bpp);
+    }
+#endif
+
     // Handle delta if needed
     if (info->is_delta) {
         qgf_delta_v1_t delta_descriptor;
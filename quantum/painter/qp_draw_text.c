@@ -32,8 +32,22 @@ typedef struct qff_font_handle_t {
     bool  owns_buffer;
     void *buffer;
 #endif // QUANTUM_PAINTER_LOAD_FONTS_TO_RAM
+#if QUANTUM_PAINTER_FONT_ATLAS
+    struct qff_atlas_glyph_t *atlas_glyphs; // Also owns the glyph data, which directly follows the glyph entries
+    uint8_t                  *atlas_data;
+    uint16_t                  atlas_count;
+#endif // QUANTUM_PAINTER_FONT_ATLAS
 } qff_font_handle_t;
 
+#if QUANTUM_PAINTER_FONT_ATLAS
+// Glyph data is stored exactly as it comes out of the decompressor, i.e. palette indices packed at the font's bpp
+typedef struct qff_atlas_glyph_t {
+    uint32_t code_point;
+    uint32_t offset;
+    uint8_t  width;
+} qff_atlas_glyph_t;
+#endif // QUANTUM_PAINTER_FONT_ATLAS
+
 static qff_font_handle_t font_descriptors[QUANTUM_PAINTER_NUM_FONTS] = {0};
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -68,6 +82,12 @@ static painter_font_handle_t qp_load_font_internal(bool (*stream_factory)(qff_fo
         return NULL;
     }
 
+#if QUANTUM_PAINTER_FONT_ATLAS
+    font->atlas_glyphs = NULL;
+    font->atlas_data   = NULL;
+    font->atlas_count  = 0;
+#endif // QUANTUM_PAINTER_FONT_ATLAS
+
 #if QUANTUM_PAINTER_LOAD_FONTS_TO_RAM
     // Clear out any existing data
     font->owns_buffer = false;
@@ -151,6 +171,13 @@ bool qp_close_font(painter_font_handle_t font) {
     }
 #endif // QUANTUM_PAINTER_LOAD_FONTS_TO_RAM
 
+#if QUANTUM_PAINTER_FONT_ATLAS
+    free(qff_font->atlas_glyphs);
+    qff_font->atlas_glyphs = NULL;
+    qff_font->atlas_data   = NULL;
+    qff_font->atlas_count  = 0;
+#endif // QUANTUM_PAINTER_FONT_ATLAS
+
     // Free up this font for use elsewhere.
     qp_stream_close(&qff_font->stream);
     qff_font->validate_ok = false;
@@ -316,6 +343,182 @@ static inline bool qp_iterate_code_points(qff_font_handle_t *qff_font, const cha
     return true;
 }
 
+#if QUANTUM_PAINTER_FONT_ATLAS
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Glyph atlas
+
+static const qff_atlas_glyph_t *qp_font_atlas_find(qff_font_handle_t *qff_font, uint32_t code_point) {
+    for (uint16_t i = 0; i < qff_font->atlas_count; ++i) {
+        if (qff_font->atlas_glyphs[i].code_point == code_point) {
+            return &qff_font->atlas_glyphs[i];
+        }
+    }
+    return NULL;
+}
+
+// Returns true if every glyph of the string is in the atlas, along with the total width of the string
+static bool qp_font_atlas_covers(qff_font_handle_t *qff_font, const char *str, int16_t *width) {
+    if (!qff_font->atlas_glyphs) {
+        return false;
+    }
+
+    *width = 0;
+    while (*str) {
+        int32_t code_point = 0;
+        str                = decode_utf8(str, &code_point);
+        if (code_point < 0) {
+            return false;
+        }
+
+        const qff_atlas_glyph_t *glyph = qp_font_atlas_find(qff_font, code_point);
+        if (!glyph) {
+            return false;
+        }
+        *width += glyph->width;
+    }
+    return true;
+}
+
+// Renders the whole string through one viewport, a pixel row at a time across all glyphs
+static bool qp_drawtext_atlas_render(painter_device_t device, uint16_t x, uint16_t y, qff_font_handle_t *qff_font, const char *str, int16_t width) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+    const uint8_t     height = qff_font->base.line_height;
+    const uint8_t     bpp    = qff_font->bpp;
+    const uint8_t     mask   = (1 << bpp) - 1;
+
+    if (width <= 0) {
+        return true;
+    }
+
+    if (!driver->driver_vtable->viewport(device, x, y, x + width - 1, y + height - 1)) {
+        return false;
+    }
+
+    qp_internal_pixel_output_state_t output_state = {.device = device, .pixel_write_pos = 0, .max_pixels = qp_internal_num_pixels_in_buffer(device)};
+    uint8_t                          indices[QUANTUM_PAINTER_DECODE_BATCH_SIZE];
+    uint16_t                         count = 0;
+
+    for (uint8_t row = 0; row < height; ++row) {
+        const char *s = str;
+        while (*s) {
+            int32_t code_point = 0;
+            s                  = decode_utf8(s, &code_point);
+
+            const qff_atlas_glyph_t *glyph = qp_font_atlas_find(qff_font, code_point);
+            const uint8_t           *data  = &qff_font->atlas_data[glyph->offset];
+            uint32_t                 bit   = (uint32_t)row * glyph->width * bpp;
+            for (uint8_t col = 0; col < glyph->width; ++col, bit += bpp) {
+                indices[count++] = (data[bit / 8] >> (bit % 8)) & mask;
+                if (count == QUANTUM_PAINTER_DECODE_BATCH_SIZE) {
+                    if (!qp_internal_append_indices(device, indices, count, &output_state)) {
+                        return false;
+                    }
+                    count = 0;
+                }
+            }
+        }
+    }
+
+    if (count > 0 && !qp_internal_append_indices(device, indices, count, &output_state)) {
+        return false;
+    }
+
+    // Any leftovers need transmission as well.
+    if (output_state.pixel_write_pos > 0) {
+        return driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, output_state.pixel_write_pos);
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_load_font_atlas
+
+bool qp_load_font_atlas(painter_font_handle_t font, const char *charset) {
+    qff_font_handle_t *qff_font = (qff_font_handle_t *)font;
+    if (!qff_font || !qff_font->validate_ok) {
+        qp_dprintf("qp_load_font_atlas: fail (invalid font)\n");
+        return false;
+    }
+
+    if (qff_font->bpp > 8) {
+        qp_dprintf("qp_load_font_atlas: fail (native pixel format fonts are not supported)\n");
+        return false;
+    }
+
+    // Drop any previous atlas
+    free(qff_font->atlas_glyphs);
+    qff_font->atlas_glyphs = NULL;
+    qff_font->atlas_data   = NULL;
+    qff_font->atlas_count  = 0;
+
+    // First pass works out how much space is needed
+    uint16_t    glyph_count = 0;
+    uint32_t    data_size   = 0;
+    const char *str         = charset;
+    while (*str) {
+        int32_t code_point = 0;
+        str                = decode_utf8(str, &code_point);
+
+        uint8_t width;
+        if (code_point < 0 || !qp_drawtext_prepare_glyph_for_render(qff_font, code_point, &width)) {
+            qp_dprintf("qp_load_font_atlas: fail (could not find glyph)\n");
+            return false;
+        }
+
+        ++glyph_count;
+        data_size += ((uint32_t)width * qff_font->base.line_height * qff_font->bpp + 7) / 8;
+    }
+
+    qff_atlas_glyph_t *glyphs = malloc(glyph_count * sizeof(qff_atlas_glyph_t) + data_size);
+    if (!glyphs) {
+        qp_dprintf("qp_load_font_atlas: fail (could not allocate %d bytes)\n", (int)(glyph_count * sizeof(qff_atlas_glyph_t) + data_size));
+        return false;
+    }
+    uint8_t *data = (uint8_t *)&glyphs[glyph_count];
+
+    // Second pass decompresses each glyph into the atlas
+    qp_internal_byte_input_state_t  input_state    = {.device = NULL, .src_stream = &qff_font->stream};
+    qp_internal_byte_input_callback input_callback = qp_internal_prepare_input_state(&input_state, qff_font->compression_scheme);
+    uint32_t                        offset         = 0;
+    str                                            = charset;
+    for (uint16_t i = 0; i < glyph_count && input_callback; ++i) {
+        int32_t code_point = 0;
+        str                = decode_utf8(str, &code_point);
+
+        uint8_t width;
+        if (!qp_drawtext_prepare_glyph_for_render(qff_font, code_point, &width)) {
+            input_callback = NULL;
+            break;
+        }
+
+        glyphs[i] = (qff_atlas_glyph_t){.code_point = code_point, .offset = offset, .width = width};
+
+        input_state.rle.mode = MARKER_BYTE; // ignored if not using RLE
+        uint32_t glyph_bytes = ((uint32_t)width * qff_font->base.line_height * qff_font->bpp + 7) / 8;
+        for (uint32_t j = 0; j < glyph_bytes; ++j) {
+            int16_t byteval = input_callback(&input_state);
+            if (byteval < 0) {
+                input_callback = NULL;
+                break;
+            }
+            data[offset++] = byteval;
+        }
+    }
+
+    if (!input_callback) {
+        qp_dprintf("qp_load_font_atlas: fail (could not decode glyph data)\n");
+        free(glyphs);
+        return false;
+    }
+
+    qff_font->atlas_glyphs = glyphs;
+    qff_font->atlas_data   = data;
+    qff_font->atlas_count  = glyph_count;
+    qp_dprintf("qp_load_font_atlas: ok (%d glyphs, %d bytes)\n", (int)glyph_count, (int)data_size);
+    return true;
+}
+#endif // QUANTUM_PAINTER_FONT_ATLAS
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // String width calculation
 
@@ -379,6 +582,13 @@ int16_t qp_textwidth(painter_font_handle_t font, const char *str) {
         return false;
     }
 
+#if QUANTUM_PAINTER_FONT_ATLAS
+    int16_t atlas_width;
+    if (qp_font_atlas_covers(qff_font, str, &atlas_width)) {
+        return atlas_width;
+    }
+#endif // QUANTUM_PAINTER_FONT_ATLAS
+
     // Create the codepoint iterator state
     code_point_iter_calcwidth_state_t state = {.width = 0};
     // Iterate each codepoint, return the calculated width if successful.
@@ -448,6 +658,16 @@ int16_t qp_drawtext_recolor(painter_device_t device, uint16_t x, uint16_t y, pai
         return false;
     }
 
+#if QUANTUM_PAINTER_FONT_ATLAS
+    int16_t atlas_width;
+    if (qp_font_atlas_covers(qff_font, str, &atlas_width)) {
+        bool ret = qp_drawtext_atlas_render(device, x, y, qff_font, str, atlas_width);
+        qp_dprintf("qp_drawtext_recolor: %s (atlas)\n", ret ? "ok" : "fail");
+        qp_comms_stop(device);
+        return ret ? atlas_width : 0;
+    }
+#endif // QUANTUM_PAINTER_FONT_ATLAS
+
     // Iterate the codepoints with the drawglyph callback
     bool ret = qp_iterate_code_points(qff_font, str, qp_font_code_point_handler_drawglyph, &state);
 
@@ -0,0 +1,80 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "pointing_device_accel.h"
+#include "pointing_device.h"
+#include "util.h"
+
+#ifdef POINTING_DEVICE_ACCEL_ENABLE
+
+static const uint16_t accel_curve[] = POINTING_DEVICE_ACCEL_CURVE;
+
+#    define ACCEL_CURVE_POINTS ARRAY_SIZE(accel_curve)
+
+_Static_assert(ACCEL_CURVE_POINTS >= 2, "POINTING_DEVICE_ACCEL_CURVE needs at least two points");
+_Static_assert(POINTING_DEVICE_ACCEL_CURVE_STEP > 0, "POINTING_DEVICE_ACCEL_CURVE_STEP must be greater than zero");
+
+uint16_t pointing_device_accel_get_factor(uint16_t speed) {
+    uint16_t index = speed / POINTING_DEVICE_ACCEL_CURVE_STEP;
+
+    if (index >= ACCEL_CURVE_POINTS - 1) {
+        return accel_curve[ACCEL_CURVE_POINTS - 1];
+    }
+
+    /* Linear interpolation between the two neighbouring curve points */
+    int32_t lo   = accel_curve[index];
+    int32_t hi   = accel_curve[index + 1];
+    int32_t frac = speed % POINTING_DEVICE_ACCEL_CURVE_STEP;
+    return (uint16_t)(lo + (hi - lo) * frac / POINTING_DEVICE_ACCEL_CURVE_STEP);
+}
+
+static inline uint16_t accel_abs(mouse_xy_report_t value) {
+    return value < 0 ? -(int32_t)value : value;
+}
+
+/*
+ * Accumulate a single axis in Q8 and return the whole counts to send.
+ * Truncation is towards zero, so the remainder always carries the sign of the motion; it is dropped on a change
+ * of direction so that leftover sub-pixel motion never pulls the cursor backwards.
+ */
+static mouse_xy_report_t accel_axis(int32_t *remainder, mouse_xy_report_t value, uint16_t factor) {
+    if ((value > 0 && *remainder < 0) || (value < 0 && *remainder > 0)) {
+        *remainder = 0;
+    }
+
+    int32_t total = *remainder + (int32_t)value * factor;
+    int32_t out   = total / POINTING_DEVICE_ACCEL_UNITY;
+
+    if (out > XY_REPORT_MAX) {
+        *remainder = 0;
+        return XY_REPORT_MAX;
+    } else if (out < XY_REPORT_MIN) {
+        *remainder = 0;
+        return XY_REPORT_MIN;
+    }
+
+    *remainder = total - out * POINTING_DEVICE_ACCEL_UNITY;
+    return (mouse_xy_report_t)out;
+}
+
+report_mouse_t pointing_device_accel_apply(pointing_device_accel_t *accel, report_mouse_t mouse_report) {
+    if (mouse_report.x == 0 && mouse_report.y == 0) {
+        return mouse_report;
+    }
+
+    /* Octagonal approximation of the vector length, avoids sqrt while staying within ~12% */
+    uint16_t ax    = accel_abs(mouse_report.x);
+    uint16_t ay    = accel_abs(mouse_report.y);
+    uint16_t speed = ax > ay ? ax + (ay >> 1) : ay + (ax >> 1);
+
+    uint16_t factor = pointing_device_accel_get_factor(speed);
+    mouse_report.x  = accel_axis(&accel->x, mouse_report.x, factor);
+    mouse_report.y  = accel_axis(&accel->y, mouse_report.y, factor);
+    return mouse_report;
+}
+
+void pointing_device_accel_reset(pointing_device_accel_t *accel) {
+    memset(accel, 0, sizeof(pointing_device_accel_t));
+}
+#endif
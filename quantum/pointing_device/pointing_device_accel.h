@@ -0,0 +1,36 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include "report.h"
+
+#ifdef POINTING_DEVICE_ACCEL_ENABLE
+
+/* Multipliers are Q8 fixed point, 256 == 1.0x */
+#    define POINTING_DEVICE_ACCEL_UNITY 256
+
+#    ifndef POINTING_DEVICE_ACCEL_CURVE_STEP
+#        define POINTING_DEVICE_ACCEL_CURVE_STEP 2
+#    endif
+
+#    ifndef POINTING_DEVICE_ACCEL_CURVE
+#        define POINTING_DEVICE_ACCEL_CURVE \
+            { 128, 160, 192, 224, 256, 288, 320, 352, 384, 416, 448, 480, 512, 512, 512, 512 }
+#    endif
+
+typedef struct {
+    int32_t x; /* Sub-pixel remainder, in Q8 */
+    int32_t y; /* Sub-pixel remainder, in Q8 */
+} pointing_device_accel_t;
+
+/* Look up the Q8 multiplier for a given per-report speed, in counts */
+uint16_t pointing_device_accel_get_factor(uint16_t speed);
+
+/* Apply the acceleration curve to the x/y motion, keeping sub-pixel remainders in accel */
+report_mouse_t pointing_device_accel_apply(pointing_device_accel_t *accel, report_mouse_t mouse_report);
+
+/* Discard any accumulated sub-pixel motion */
+void pointing_device_accel_reset(pointing_device_accel_t *accel);
+#endif
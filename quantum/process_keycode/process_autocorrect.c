@@ -19,6 +19,22 @@
 #    include "autocorrect_data_default.h"
 #endif
 
+// Dictionaries larger than 64KB are generated with 24-bit node links.
+#ifndef AUTOCORRECT_LINK_BYTES
+#    define AUTOCORRECT_LINK_BYTES 2
+#endif
+
+#if AUTOCORRECT_LINK_BYTES == 2
+typedef uint16_t autocorrect_offset_t;
+#elif AUTOCORRECT_LINK_BYTES == 3
+#    if defined(__AVR__)
+#        error "Autocorrect dictionaries larger than 64KB are not supported on AVR."
+#    endif
+typedef uint32_t autocorrect_offset_t;
+#else
+#    error "Unsupported AUTOCORRECT_LINK_BYTES, regenerate autocorrect_data.h."
+#endif
+
 static uint8_t typo_buffer[AUTOCORRECT_MAX_LENGTH] = {KC_SPC};
 static uint8_t typo_buffer_size                    = 1;
 
@@ -280,18 +296,22 @@ bool process_autocorrect(uint16_t keycode, keyrecord_t *record) {
     }
 
     // Check for typo in buffer using a trie stored in `autocorrect_data`.
-    uint16_t state = 0;
-    uint8_t  code  = pgm_read_byte(autocorrect_data + state);
+    autocorrect_offset_t state = 0;
+    uint8_t              code  = pgm_read_byte(autocorrect_data + state);
     for (int8_t i = typo_buffer_size - 1; i >= 0; --i) {
         uint8_t const key_i = typo_buffer[i];
 
         if (code & 64) { // Check for match in node with multiple children.
             code &= 63;
-            for (; code != key_i; code = pgm_read_byte(autocorrect_data + (state += 3))) {
+            for (; code != key_i; code = pgm_read_byte(autocorrect_data + (state += 1 + AUTOCORRECT_LINK_BYTES))) {
                 if (!code) return true;
             }
             // Follow link to child node.
+#if AUTOCORRECT_LINK_BYTES == 3
+            state = (pgm_read_byte(autocorrect_data + state + 1) | pgm_read_byte(autocorrect_data + state + 2) << 8 | (autocorrect_offset_t)pgm_read_byte(autocorrect_data + state + 3) << 16);
+#else
             state = (pgm_read_byte(autocorrect_data + state + 1) | pgm_read_byte(autocorrect_data + state + 2) << 8);
+#endif
             // Check for match in node with single child.
         } else if (code != key_i) {
             return true;
@@ -0,0 +1,106 @@
+#pragma once
+
+#ifdef RGB_MATRIX_LED_FRAMEBUFFER_EFFECTS
+
+typedef hsv_t (*led_frame_buffer_f)(hsv_t hsv, uint8_t i);
+
+// Closest LEDs to each LED, padded with NO_LED, shared by the blur and diffuse kernels
+static uint8_t led_frame_buffer_neighbors[RGB_MATRIX_LED_COUNT][RGB_MATRIX_LED_FRAMEBUFFER_NEIGHBORS];
+static bool    led_frame_buffer_neighbors_valid = false;
+static uint8_t led_frame_buffer_scratch[RGB_MATRIX_LED_COUNT];
+
+static void led_frame_buffer_find_neighbors(void) {
+    const uint16_t max_dist2 = RGB_MATRIX_LED_FRAMEBUFFER_RADIUS * RGB_MATRIX_LED_FRAMEBUFFER_RADIUS;
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        uint8_t* neighbors = led_frame_buffer_neighbors[i];
+        uint16_t dist2[RGB_MATRIX_LED_FRAMEBUFFER_NEIGHBORS];
+        memset(neighbors, NO_LED, RGB_MATRIX_LED_FRAMEBUFFER_NEIGHBORS);
+        for (uint8_t j = 0; j < RGB_MATRIX_LED_COUNT; j++) {
+            int16_t  dx = g_led_config.point[j].x - g_led_config.point[i].x;
+            int16_t  dy = g_led_config.point[j].y - g_led_config.point[i].y;
+            uint16_t d2 = dx * dx + dy * dy;
+            if (j == i || d2 > max_dist2) continue;
+
+            // Keep the list sorted by distance, dropping the furthest when full
+            uint8_t pos = 0;
+            while (pos < RGB_MATRIX_LED_FRAMEBUFFER_NEIGHBORS && neighbors[pos] != NO_LED && dist2[pos] <= d2) {
+                pos++;
+            }
+            if (pos == RGB_MATRIX_LED_FRAMEBUFFER_NEIGHBORS) continue;
+            for (uint8_t k = RGB_MATRIX_LED_FRAMEBUFFER_NEIGHBORS - 1; k > pos; k--) {
+                neighbors[k] = neighbors[k - 1];
+                dist2[k]     = dist2[k - 1];
+            }
+            neighbors[pos] = j;
+            dist2[pos]     = d2;
+        }
+    }
+    led_frame_buffer_neighbors_valid = true;
+}
+
+// Subtracts `amount` from every LED in the plane, stopping at zero
+void rgb_matrix_led_frame_buffer_decay(uint8_t* plane, uint8_t amount) {
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        plane[i] = plane[i] > amount ? plane[i] - amount : 0;
+    }
+}
+
+// Scales every LED in the plane by `scale` / 256
+void rgb_matrix_led_frame_buffer_fade(uint8_t* plane, uint8_t scale) {
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        plane[i] = ((uint16_t)plane[i] * scale) >> 8;
+    }
+}
+
+// Moves every LED `amount` / 256 of the way towards the average of its neighbours
+void rgb_matrix_led_frame_buffer_blur(uint8_t* plane, uint8_t amount) {
+    if (!led_frame_buffer_neighbors_valid) led_frame_buffer_find_neighbors();
+
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        uint16_t sum   = 0;
+        uint8_t  count = 0;
+        for (uint8_t k = 0; k < RGB_MATRIX_LED_FRAMEBUFFER_NEIGHBORS && led_frame_buffer_neighbors[i][k] != NO_LED; k++) {
+            sum += plane[led_frame_buffer_neighbors[i][k]];
+            count++;
+        }
+        led_frame_buffer_scratch[i] = count ? blend8(plane[i], sum / count, amount) : plane[i];
+    }
+    memcpy(plane, led_frame_buffer_scratch, RGB_MATRIX_LED_COUNT);
+}
+
+// Every LED hands `amount` / 256 of its value out evenly to its neighbours, so the total is (mostly) conserved
+void rgb_matrix_led_frame_buffer_diffuse(uint8_t* plane, uint8_t amount) {
+    if (!led_frame_buffer_neighbors_valid) led_frame_buffer_find_neighbors();
+
+    memcpy(led_frame_buffer_scratch, plane, RGB_MATRIX_LED_COUNT);
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        uint8_t count = 0;
+        while (count < RGB_MATRIX_LED_FRAMEBUFFER_NEIGHBORS && led_frame_buffer_neighbors[i][count] != NO_LED) {
+            count++;
+        }
+        if (!count) continue;
+
+        uint8_t share = scale8(plane[i], amount) / count;
+        if (!share) continue;
+
+        led_frame_buffer_scratch[i] -= share * count;
+        for (uint8_t k = 0; k < count; k++) {
+            uint8_t j                   = led_frame_buffer_neighbors[i][k];
+            led_frame_buffer_scratch[j] = qadd8(led_frame_buffer_scratch[j], share);
+        }
+    }
+    memcpy(plane, led_frame_buffer_scratch, RGB_MATRIX_LED_COUNT);
+}
+
+bool effect_runner_led_frame_buffer(effect_params_t* params, led_frame_buffer_f effect_func) {
+    RGB_MATRIX_USE_LIMITS(led_min, led_max);
+
+    for (uint8_t i = led_min; i < led_max; i++) {
+        RGB_MATRIX_TEST_LED_FLAGS();
+        rgb_t rgb = rgb_matrix_hsv_to_rgb(effect_func(rgb_matrix_config.hsv, i));
+        rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
+    }
+    return rgb_matrix_check_finished_leds(led_max);
+}
+
+#endif // RGB_MATRIX_LED_FRAMEBUFFER_EFFECTS
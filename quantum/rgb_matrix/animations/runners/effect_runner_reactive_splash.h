@@ -2,22 +2,93 @@
 
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 
+// Scaled tick beyond which a hit no longer lights anything -- the splash effects saturate once `tick - dist` reaches 255
+#    ifndef RGB_MATRIX_SPLASH_TICK_LIMIT
+#        define RGB_MATRIX_SPLASH_TICK_LIMIT 510
+#    endif
+
 typedef hsv_t (*reactive_splash_f)(hsv_t hsv, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick);
 
+#    ifdef RGB_MATRIX_SPLASH_DISTANCE_CACHE
+_Static_assert(LED_HITS_TO_REMEMBER <= 32, "RGB_MATRIX_SPLASH_DISTANCE_CACHE supports at most 32 remembered hits");
+
+// Distances from every LED to the LED of a remembered hit, one row per hit
+static uint8_t  splash_distance[LED_HITS_TO_REMEMBER][RGB_MATRIX_LED_COUNT];
+static uint8_t  splash_distance_led[LED_HITS_TO_REMEMBER];
+static uint32_t splash_distance_valid = 0;
+
+static void splash_distance_fill(uint8_t row, uint8_t hit) {
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        int16_t dx              = g_led_config.point[i].x - g_last_hit_tracker.x[hit];
+        int16_t dy              = g_led_config.point[i].y - g_last_hit_tracker.y[hit];
+        splash_distance[row][i] = sqrt16(dx * dx + dy * dy);
+    }
+    splash_distance_led[row] = g_last_hit_tracker.index[hit];
+    splash_distance_valid |= (uint32_t)1 << row;
+}
+
+// Finds the distance rows for the supplied hits, computing rows for hits which haven't been seen before
+static void splash_distance_lookup(const uint8_t *hits, uint8_t hit_count, const uint8_t **rows) {
+    uint32_t used = 0;
+    for (uint8_t k = 0; k < hit_count; k++) {
+        rows[k] = NULL;
+        for (uint8_t r = 0; r < LED_HITS_TO_REMEMBER; r++) {
+            if ((splash_distance_valid & ((uint32_t)1 << r)) && splash_distance_led[r] == g_last_hit_tracker.index[hits[k]]) {
+                rows[k] = splash_distance[r];
+                used |= (uint32_t)1 << r;
+                break;
+            }
+        }
+    }
+
+    // There are always enough rows for every remembered hit, so any row not used this frame can be replaced
+    uint8_t r = 0;
+    for (uint8_t k = 0; k < hit_count; k++) {
+        if (rows[k]) continue;
+        while (used & ((uint32_t)1 << r)) {
+            r++;
+        }
+        splash_distance_fill(r, hits[k]);
+        rows[k] = splash_distance[r];
+        used |= (uint32_t)1 << r;
+    }
+}
+#    endif // RGB_MATRIX_SPLASH_DISTANCE_CACHE
+
 bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, reactive_splash_f effect_func) {
     RGB_MATRIX_USE_LIMITS(led_min, led_max);
 
-    uint8_t count = g_last_hit_tracker.count;
+    // Work out which hits are still visible, and their ticks, once rather than for every LED
+    uint8_t  hits[LED_HITS_TO_REMEMBER];
+    uint16_t ticks[LED_HITS_TO_REMEMBER];
+    uint8_t  hit_count = 0;
+    uint8_t  count     = g_last_hit_tracker.count;
+    for (uint8_t j = start; j < count; j++) {
+        uint16_t tick = scale16by8(g_last_hit_tracker.tick[j], qadd8(rgb_matrix_config.speed, 1));
+        if (tick >= RGB_MATRIX_SPLASH_TICK_LIMIT) continue;
+        hits[hit_count]  = j;
+        ticks[hit_count] = tick;
+        hit_count++;
+    }
+
+#    ifdef RGB_MATRIX_SPLASH_DISTANCE_CACHE
+    const uint8_t* distances[LED_HITS_TO_REMEMBER];
+    splash_distance_lookup(hits, hit_count, distances);
+#    endif
+
     for (uint8_t i = led_min; i < led_max; i++) {
         RGB_MATRIX_TEST_LED_FLAGS();
         hsv_t hsv = rgb_matrix_config.hsv;
         hsv.v     = 0;
-        for (uint8_t j = start; j < count; j++) {
-            int16_t  dx   = g_led_config.point[i].x - g_last_hit_tracker.x[j];
-            int16_t  dy   = g_led_config.point[i].y - g_last_hit_tracker.y[j];
-            uint8_t  dist = sqrt16(dx * dx + dy * dy);
-            uint16_t tick = scale16by8(g_last_hit_tracker.tick[j], qadd8(rgb_matrix_config.speed, 1));
-            hsv           = effect_func(hsv, dx, dy, dist, tick);
+        for (uint8_t k = 0; k < hit_count; k++) {
+            int16_t dx = g_led_config.point[i].x - g_last_hit_tracker.x[hits[k]];
+            int16_t dy = g_led_config.point[i].y - g_last_hit_tracker.y[hits[k]];
+#    ifdef RGB_MATRIX_SPLASH_DISTANCE_CACHE
+            uint8_t dist = distances[k][i];
+#    else
+            uint8_t dist = sqrt16(dx * dx + dy * dy);
+#    endif
+            hsv = effect_func(hsv, dx, dy, dist, ticks[k]);
         }
         hsv.v     = scale8(hsv.v, rgb_matrix_config.hsv.v);
         rgb_t rgb = rgb_matrix_hsv_to_rgb(hsv);
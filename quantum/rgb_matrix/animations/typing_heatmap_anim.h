@@ -16,41 +16,126 @@ RGB_MATRIX_EFFECT(TYPING_HEATMAP)
 #        ifndef RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT
 #            define RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT 16
 #        endif
+#        if MATRIX_ROWS * MATRIX_COLS >= UINT8_MAX
+typedef uint16_t heatmap_cell_t;
+#        else
+typedef uint8_t heatmap_cell_t;
+#        endif
+
+// Cells of g_rgb_frame_buffer which are above zero, so that only those need decreasing
+static heatmap_cell_t heatmap_active[MATRIX_ROWS * MATRIX_COLS];
+static heatmap_cell_t heatmap_active_count = 0;
+
+static void heatmap_increase(heatmap_cell_t cell, uint8_t amount) {
+    uint8_t* heat = &g_rgb_frame_buffer[0][0];
+    if (heat[cell] == 0 && amount) {
+        heatmap_active[heatmap_active_count++] = cell;
+    }
+    heat[cell] = qadd8(heat[cell], amount);
+}
+
+static void heatmap_decrease(void) {
+    uint8_t* heat = &g_rgb_frame_buffer[0][0];
+    for (heatmap_cell_t i = 0; i < heatmap_active_count;) {
+        heatmap_cell_t cell = heatmap_active[i];
+        heat[cell]          = qsub8(heat[cell], 1);
+        if (heat[cell] == 0) {
+            heatmap_active[i] = heatmap_active[--heatmap_active_count];
+        } else {
+            i++;
+        }
+    }
+}
+
+#        if !defined(RGB_MATRIX_TYPING_HEATMAP_SLIM)
+static uint8_t heatmap_spread_amount(uint8_t led_a, uint8_t led_b) {
+    int16_t dx       = g_led_config.point[led_a].x - g_led_config.point[led_b].x;
+    int16_t dy       = g_led_config.point[led_a].y - g_led_config.point[led_b].y;
+    uint8_t distance = sqrt16(dx * dx + dy * dy);
+    if (distance > RGB_MATRIX_TYPING_HEATMAP_SPREAD) {
+        return 0;
+    }
+    uint8_t amount = qsub8(RGB_MATRIX_TYPING_HEATMAP_SPREAD, distance);
+    return amount > RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT ? RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT : amount;
+}
+#        endif
+
+#        if defined(RGB_MATRIX_TYPING_HEATMAP_SPREAD_CACHE) && !defined(RGB_MATRIX_TYPING_HEATMAP_SLIM)
+#            ifndef RGB_MATRIX_TYPING_HEATMAP_SPREAD_NEIGHBORS
+#                define RGB_MATRIX_TYPING_HEATMAP_SPREAD_NEIGHBORS 16
+#            endif
+
+typedef struct {
+    heatmap_cell_t cell;
+    uint8_t        amount;
+} heatmap_spread_t;
+
+// The cells heated by a press of each LED's key, hottest first and ending early with an amount of zero
+static heatmap_spread_t heatmap_spread[RGB_MATRIX_LED_COUNT][RGB_MATRIX_TYPING_HEATMAP_SPREAD_NEIGHBORS];
+static bool             heatmap_spread_valid = false;
+
+static void heatmap_spread_fill(void) {
+    memset(heatmap_spread, 0, sizeof(heatmap_spread));
+    for (heatmap_cell_t source = 0; source < MATRIX_ROWS * MATRIX_COLS; source++) {
+        uint8_t led = g_led_config.matrix_co[source / MATRIX_COLS][source % MATRIX_COLS];
+        if (led == NO_LED) continue;
+
+        heatmap_spread_t* spread = heatmap_spread[led];
+        for (heatmap_cell_t target = 0; target < MATRIX_ROWS * MATRIX_COLS; target++) {
+            uint8_t target_led = g_led_config.matrix_co[target / MATRIX_COLS][target % MATRIX_COLS];
+            if (target == source || target_led == NO_LED) continue;
+
+            uint8_t amount = heatmap_spread_amount(led, target_led);
+            if (!amount) continue;
+
+            // Keep the list sorted by amount, dropping the coolest when full
+            uint8_t pos = 0;
+            while (pos < RGB_MATRIX_TYPING_HEATMAP_SPREAD_NEIGHBORS && spread[pos].amount >= amount) {
+                pos++;
+            }
+            if (pos == RGB_MATRIX_TYPING_HEATMAP_SPREAD_NEIGHBORS) continue;
+            for (uint8_t k = RGB_MATRIX_TYPING_HEATMAP_SPREAD_NEIGHBORS - 1; k > pos; k--) {
+                spread[k] = spread[k - 1];
+            }
+            spread[pos] = (heatmap_spread_t){.cell = target, .amount = amount};
+        }
+    }
+    heatmap_spread_valid = true;
+}
+#        endif
+
 void process_rgb_matrix_typing_heatmap(uint8_t row, uint8_t col) {
+    heatmap_cell_t cell = row * MATRIX_COLS + col;
 #        ifdef RGB_MATRIX_TYPING_HEATMAP_SLIM
     // Limit effect to pressed keys
-    g_rgb_frame_buffer[row][col] = qadd8(g_rgb_frame_buffer[row][col], RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP);
+    heatmap_increase(cell, RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP);
 #        else
-    if (g_led_config.matrix_co[row][col] == NO_LED) { // skip as pressed key doesn't have an led position
+    uint8_t led = g_led_config.matrix_co[row][col];
+    if (led == NO_LED) { // skip as pressed key doesn't have an led position
         return;
     }
-    for (uint8_t i_row = 0; i_row < MATRIX_ROWS; i_row++) {
-        for (uint8_t i_col = 0; i_col < MATRIX_COLS; i_col++) {
-            if (g_led_config.matrix_co[i_row][i_col] == NO_LED) { // skip as target key doesn't have an led position
-                continue;
-            }
-            if (i_row == row && i_col == col) {
-                g_rgb_frame_buffer[row][col] = qadd8(g_rgb_frame_buffer[row][col], RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP);
-            } else {
-#            define LED_DISTANCE(led_a, led_b) sqrt16(((int16_t)(led_a.x - led_b.x) * (int16_t)(led_a.x - led_b.x)) + ((int16_t)(led_a.y - led_b.y) * (int16_t)(led_a.y - led_b.y)))
-                uint8_t distance = LED_DISTANCE(g_led_config.point[g_led_config.matrix_co[row][col]], g_led_config.point[g_led_config.matrix_co[i_row][i_col]]);
-#            undef LED_DISTANCE
-                if (distance <= RGB_MATRIX_TYPING_HEATMAP_SPREAD) {
-                    uint8_t amount = qsub8(RGB_MATRIX_TYPING_HEATMAP_SPREAD, distance);
-                    if (amount > RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT) {
-                        amount = RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT;
-                    }
-                    g_rgb_frame_buffer[i_row][i_col] = qadd8(g_rgb_frame_buffer[i_row][i_col], amount);
-                }
-            }
+    heatmap_increase(cell, RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP);
+#            ifdef RGB_MATRIX_TYPING_HEATMAP_SPREAD_CACHE
+    if (!heatmap_spread_valid) heatmap_spread_fill();
+
+    for (uint8_t k = 0; k < RGB_MATRIX_TYPING_HEATMAP_SPREAD_NEIGHBORS && heatmap_spread[led][k].amount; k++) {
+        heatmap_increase(heatmap_spread[led][k].cell, heatmap_spread[led][k].amount);
+    }
+#            else
+    for (heatmap_cell_t target = 0; target < MATRIX_ROWS * MATRIX_COLS; target++) {
+        uint8_t target_led = g_led_config.matrix_co[target / MATRIX_COLS][target % MATRIX_COLS];
+        if (target == cell || target_led == NO_LED) { // skip as target key doesn't have an led position
+            continue;
         }
+        heatmap_increase(target, heatmap_spread_amount(led, target_led));
     }
+#            endif
 #        endif
 }
 
 // A timer to track the last time we decremented all heatmap values.
 static uint16_t heatmap_decrease_timer;
-// Whether we should decrement the heatmap values during the next update.
+// Whether we should decrement the heatmap values once this frame has been rendered.
 static bool decrease_heatmap_values;
 
 bool TYPING_HEATMAP(effect_params_t* params) {
@@ -59,6 +144,10 @@ bool TYPING_HEATMAP(effect_params_t* params) {
     if (params->init) {
         rgb_matrix_set_color_all(0, 0, 0);
         memset(g_rgb_frame_buffer, 0, sizeof g_rgb_frame_buffer);
+        heatmap_active_count = 0;
+#        if defined(RGB_MATRIX_TYPING_HEATMAP_SPREAD_CACHE) && !defined(RGB_MATRIX_TYPING_HEATMAP_SLIM)
+        if (!heatmap_spread_valid) heatmap_spread_fill();
+#        endif
     }
 
     // The heatmap animation might run in several iterations depending on
@@ -73,7 +162,7 @@ bool TYPING_HEATMAP(effect_params_t* params) {
         }
     }
 
-    // Render heatmap & decrease
+    // Render heatmap
     uint8_t count = 0;
     for (uint8_t row = 0; row < MATRIX_ROWS && count < RGB_MATRIX_LED_PROCESS_LIMIT; row++) {
         for (uint8_t col = 0; col < MATRIX_COLS && RGB_MATRIX_LED_PROCESS_LIMIT; col++) {
@@ -85,15 +174,16 @@ bool TYPING_HEATMAP(effect_params_t* params) {
                 hsv_t hsv = {170 - qsub8(val, 85), rgb_matrix_config.hsv.s, scale8((qadd8(170, val) - 170) * 3, rgb_matrix_config.hsv.v)};
                 rgb_t rgb = rgb_matrix_hsv_to_rgb(hsv);
                 rgb_matrix_set_color(g_led_config.matrix_co[row][col], rgb.r, rgb.g, rgb.b);
-
-                if (decrease_heatmap_values) {
-                    g_rgb_frame_buffer[row][col] = qsub8(val, 1);
-                }
             }
         }
     }
 
-    return rgb_matrix_check_finished_leds(led_max);
+    // Only the warm keys need decreasing, and only once every LED has been drawn
+    bool more = rgb_matrix_check_finished_leds(led_max);
+    if (!more && decrease_heatmap_values) {
+        heatmap_decrease();
+    }
+    return more;
 }
 
 #    endif // RGB_MATRIX_CUSTOM_EFFECT_IMPLS
@@ -66,6 +66,9 @@ uint32_t     g_rgb_timer;
 #ifdef RGB_MATRIX_FRAMEBUFFER_EFFECTS
 uint8_t g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS] = {{0}};
 #endif // RGB_MATRIX_FRAMEBUFFER_EFFECTS
+#ifdef RGB_MATRIX_LED_FRAMEBUFFER_EFFECTS
+uint8_t g_rgb_led_frame_buffer[RGB_MATRIX_LED_FRAMEBUFFER_PLANES][RGB_MATRIX_LED_COUNT] = {{0}};
+#endif // RGB_MATRIX_LED_FRAMEBUFFER_EFFECTS
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 last_hit_t g_last_hit_tracker;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
@@ -86,6 +89,10 @@ static last_hit_t last_hit_buffer;
 // split rgb matrix
 #if defined(RGB_MATRIX_SPLIT)
 const uint8_t k_rgb_matrix_split[2] = RGB_MATRIX_SPLIT;
+#    ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+_Static_assert((RGB_MATRIX_SPLIT_HIT_EVENTS & (RGB_MATRIX_SPLIT_HIT_EVENTS - 1)) == 0, "RGB_MATRIX_SPLIT_HIT_EVENTS must be a power of two");
+static rgb_matrix_hit_events_t hit_events;
+#    endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 #endif
 
 EECONFIG_DEBOUNCE_HELPER(rgb_matrix, EECONFIG_RGB_MATRIX, rgb_matrix_config);
@@ -152,52 +159,214 @@ __attribute__((weak)) int rgb_matrix_led_index(int index) {
     return index;
 }
 
+#ifdef RGB_MATRIX_OUTPUT_LUT
+// Final correction for each channel: white balance, then the output limit.
+// Gamma stays on the HSV value in rgb_matrix_hsv_to_rgb(), so hues mix as before.
+static uint8_t output_lut[3][256];
+static uint8_t output_white_balance[3] = RGB_MATRIX_WHITE_BALANCE;
+static uint8_t output_limit            = RGB_MATRIX_OUTPUT_LIMIT;
+
+static void rgb_matrix_output_lut_update(void) {
+    for (uint8_t channel = 0; channel < 3; channel++) {
+        // Scaling by (x + 1) / 256 keeps 255 at 255 when nothing is being reduced
+        uint16_t factor = ((output_white_balance[channel] + 1) * (output_limit + 1)) >> 8;
+        for (uint16_t i = 0; i < 256; i++) {
+            output_lut[channel][i] = (i * factor) >> 8;
+        }
+    }
+}
+
+void rgb_matrix_set_white_balance(uint8_t red, uint8_t green, uint8_t blue) {
+    output_white_balance[0] = red;
+    output_white_balance[1] = green;
+    output_white_balance[2] = blue;
+    rgb_matrix_output_lut_update();
+}
+
+void rgb_matrix_set_output_limit(uint8_t limit) {
+    output_limit = limit;
+    rgb_matrix_output_lut_update();
+}
+#endif // RGB_MATRIX_OUTPUT_LUT
+
+#ifdef RGB_MATRIX_CURRENT_BUDGET
+// A fully lit LED has to fit the 16 bit per LED estimate below
+_Static_assert(RGB_MATRIX_CURRENT_RED <= 85, "RGB_MATRIX_CURRENT_RED must be at most 85");
+_Static_assert(RGB_MATRIX_CURRENT_GREEN <= 85, "RGB_MATRIX_CURRENT_GREEN must be at most 85");
+_Static_assert(RGB_MATRIX_CURRENT_BLUE <= 85, "RGB_MATRIX_CURRENT_BLUE must be at most 85");
+
+// Estimated current of each LED as last written, in 1/255 mA, and their running total,
+// so every write only has to account for the difference
+static const uint8_t current_coefficients[3] = {RGB_MATRIX_CURRENT_RED, RGB_MATRIX_CURRENT_GREEN, RGB_MATRIX_CURRENT_BLUE};
+static uint16_t      current_led[RGB_MATRIX_LED_COUNT];
+static uint32_t      current_total  = 0;
+static uint16_t      current_budget = RGB_MATRIX_CURRENT_BUDGET_UNCONFIGURED;
+static uint16_t      current_scale  = 256;
+
+static inline uint16_t rgb_matrix_current_load(uint8_t red, uint8_t green, uint8_t blue) {
+    return red * current_coefficients[0] + green * current_coefficients[1] + blue * current_coefficients[2];
+}
+
+// Works out how much the next frame needs scaling by to fit the budget, based on what this frame asked for
+static void rgb_matrix_current_update_scale(void) {
+    uint32_t estimate = current_total / 255;
+    current_scale     = estimate > current_budget ? ((uint32_t)current_budget << 8) / estimate : 256;
+}
+
+void rgb_matrix_set_current_budget(uint16_t budget) {
+    current_budget = budget;
+}
+
+uint16_t rgb_matrix_get_current_budget(void) {
+    return current_budget;
+}
+
+uint16_t rgb_matrix_get_current_estimate(void) {
+    return current_total / 255;
+}
+
+// The slave half of a split keyboard never hears from the host, and runs off the power the master negotiated
+static void rgb_matrix_current_budget_reset(bool configured) {
+    current_budget = configured || !is_keyboard_master() ? RGB_MATRIX_CURRENT_BUDGET : RGB_MATRIX_CURRENT_BUDGET_UNCONFIGURED;
+}
+
+void rgb_matrix_notify_usb_device_state_change(struct usb_device_state usb_device_state) {
+    rgb_matrix_current_budget_reset(usb_device_state.configure_state == USB_DEVICE_STATE_CONFIGURED);
+}
+#endif // RGB_MATRIX_CURRENT_BUDGET
+
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+#ifdef RGB_MATRIX_OUTPUT_LUT
+    red   = output_lut[0][red];
+    green = output_lut[1][green];
+    blue  = output_lut[2][blue];
+#endif
+#ifdef RGB_MATRIX_CURRENT_BUDGET
+    if (index >= 0 && index < RGB_MATRIX_LED_COUNT) {
+        uint16_t load = rgb_matrix_current_load(red, green, blue);
+        current_total += load - current_led[index];
+        current_led[index] = load;
+    }
+    if (current_scale < 256) {
+        red   = (red * current_scale) >> 8;
+        green = (green * current_scale) >> 8;
+        blue  = (blue * current_scale) >> 8;
+    }
+#endif
     rgb_matrix_driver.set_color(rgb_matrix_led_index(index), red, green, blue);
 }
 
+// The range of LEDs driven by this half
+static struct rgb_matrix_limits_t rgb_matrix_get_local_limits(void) {
+    struct rgb_matrix_limits_t limits = {0, RGB_MATRIX_LED_COUNT};
+#if defined(RGB_MATRIX_SPLIT)
+    if (is_keyboard_left()) {
+        limits.led_max_index = k_rgb_matrix_split[0];
+    } else {
+        limits.led_min_index = k_rgb_matrix_split[0];
+    }
+#endif
+    return limits;
+}
+
 void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
 #if defined(RGB_MATRIX_SPLIT)
-    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++)
+    struct rgb_matrix_limits_t limits = rgb_matrix_get_local_limits();
+    for (uint8_t i = limits.led_min_index; i < limits.led_max_index; i++)
         rgb_matrix_set_color(i, red, green, blue);
 #else
+#    ifdef RGB_MATRIX_OUTPUT_LUT
+    red   = output_lut[0][red];
+    green = output_lut[1][green];
+    blue  = output_lut[2][blue];
+#    endif
+#    ifdef RGB_MATRIX_CURRENT_BUDGET
+    uint16_t load = rgb_matrix_current_load(red, green, blue);
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        current_led[i] = load;
+    }
+    current_total = (uint32_t)load * RGB_MATRIX_LED_COUNT;
+    if (current_scale < 256) {
+        red   = (red * current_scale) >> 8;
+        green = (green * current_scale) >> 8;
+        blue  = (blue * current_scale) >> 8;
+    }
+#    endif
     rgb_matrix_driver.set_color_all(red, green, blue);
 #endif
 }
 
+#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+static void rgb_matrix_add_hit(uint8_t led, uint16_t tick) {
+    if (last_hit_buffer.count == LED_HITS_TO_REMEMBER) {
+        memmove(&last_hit_buffer.x[0], &last_hit_buffer.x[1], LED_HITS_TO_REMEMBER - 1);
+        memmove(&last_hit_buffer.y[0], &last_hit_buffer.y[1], LED_HITS_TO_REMEMBER - 1);
+        memmove(&last_hit_buffer.tick[0], &last_hit_buffer.tick[1], (LED_HITS_TO_REMEMBER - 1) * 2); // 16 bit
+        memmove(&last_hit_buffer.index[0], &last_hit_buffer.index[1], LED_HITS_TO_REMEMBER - 1);
+        last_hit_buffer.count--;
+    }
+
+    uint8_t index                = last_hit_buffer.count;
+    last_hit_buffer.x[index]     = g_led_config.point[led].x;
+    last_hit_buffer.y[index]     = g_led_config.point[led].y;
+    last_hit_buffer.index[index] = led;
+    last_hit_buffer.tick[index]  = tick;
+    last_hit_buffer.count++;
+}
+
+#    if defined(RGB_MATRIX_SPLIT)
+// The master sees every key on both halves, so it records all hits and forwards
+// them to the slave as LED index + timestamp, rather than the slave tracking its own
+const rgb_matrix_hit_events_t *rgb_matrix_get_hit_events(void) {
+    return &hit_events;
+}
+
+void rgb_matrix_apply_hit_events(const rgb_matrix_hit_events_t *events) {
+    static uint8_t last_seq = 0;
+
+    uint8_t new_events = events->seq - last_seq;
+    if (new_events > RGB_MATRIX_SPLIT_HIT_EVENTS) new_events = RGB_MATRIX_SPLIT_HIT_EVENTS;
+    for (uint8_t seq = events->seq - new_events; seq != events->seq; seq++) {
+        uint8_t slot = seq % RGB_MATRIX_SPLIT_HIT_EVENTS;
+        rgb_matrix_add_hit(events->index[slot], sync_timer_elapsed(events->tick[slot]));
+    }
+    last_seq = events->seq;
+}
+#    endif // defined(RGB_MATRIX_SPLIT)
+#endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+
 void rgb_matrix_handle_key_event(uint8_t row, uint8_t col, bool pressed) {
 #ifndef RGB_MATRIX_SPLIT
     if (!is_keyboard_master()) return;
 #endif
 
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-    uint8_t led[LED_HITS_TO_REMEMBER];
-    uint8_t led_count = 0;
+#    if defined(RGB_MATRIX_SPLIT)
+    // Hits on the slave arrive from the master via rgb_matrix_apply_hit_events()
+    if (is_keyboard_master())
+#    endif // defined(RGB_MATRIX_SPLIT)
+    {
+        uint8_t led[LED_HITS_TO_REMEMBER];
+        uint8_t led_count = 0;
 
 #    if defined(RGB_MATRIX_KEYRELEASES)
-    if (!pressed)
+        if (!pressed)
 #    elif defined(RGB_MATRIX_KEYPRESSES)
-    if (pressed)
+        if (pressed)
 #    endif // defined(RGB_MATRIX_KEYRELEASES)
-    {
-        led_count = rgb_matrix_map_row_column_to_led(row, col, led);
-    }
-
-    if (last_hit_buffer.count + led_count > LED_HITS_TO_REMEMBER) {
-        memcpy(&last_hit_buffer.x[0], &last_hit_buffer.x[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.y[0], &last_hit_buffer.y[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.tick[0], &last_hit_buffer.tick[led_count], (LED_HITS_TO_REMEMBER - led_count) * 2); // 16 bit
-        memcpy(&last_hit_buffer.index[0], &last_hit_buffer.index[led_count], LED_HITS_TO_REMEMBER - led_count);
-        last_hit_buffer.count = LED_HITS_TO_REMEMBER - led_count;
-    }
+        {
+            led_count = rgb_matrix_map_row_column_to_led(row, col, led);
+        }
 
-    for (uint8_t i = 0; i < led_count; i++) {
-        uint8_t index                = last_hit_buffer.count;
-        last_hit_buffer.x[index]     = g_led_config.point[led[i]].x;
-        last_hit_buffer.y[index]     = g_led_config.point[led[i]].y;
-        last_hit_buffer.index[index] = led[i];
-        last_hit_buffer.tick[index]  = 0;
-        last_hit_buffer.count++;
+        for (uint8_t i = 0; i < led_count; i++) {
+            rgb_matrix_add_hit(led[i], 0);
+#    if defined(RGB_MATRIX_SPLIT)
+            uint8_t slot           = hit_events.seq % RGB_MATRIX_SPLIT_HIT_EVENTS;
+            hit_events.index[slot] = led[i];
+            hit_events.tick[slot]  = sync_timer_read();
+            hit_events.seq++;
+#    endif // defined(RGB_MATRIX_SPLIT)
+        }
     }
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
@@ -248,6 +417,32 @@ static bool rgb_matrix_none(effect_params_t *params) {
     return false;
 }
 
+typedef bool (*rgb_matrix_effect_f)(effect_params_t *params);
+
+// Every enabled effect, indexed by mode
+static const rgb_matrix_effect_f rgb_matrix_effect_funcs[RGB_MATRIX_EFFECT_MAX] PROGMEM = {
+    [RGB_MATRIX_NONE] = rgb_matrix_none,
+
+// ---------------------------------------------
+// -----Begin rgb effect table macros-----------
+#define RGB_MATRIX_EFFECT(name, ...) [RGB_MATRIX_##name] = name,
+#include "rgb_matrix_effects.inc"
+#undef RGB_MATRIX_EFFECT
+
+#if defined(RGB_MATRIX_CUSTOM_KB) || defined(RGB_MATRIX_CUSTOM_USER)
+#    define RGB_MATRIX_EFFECT(name, ...) [RGB_MATRIX_CUSTOM_##name] = name,
+#    ifdef RGB_MATRIX_CUSTOM_KB
+#        include "rgb_matrix_kb.inc"
+#    endif
+#    ifdef RGB_MATRIX_CUSTOM_USER
+#        include "rgb_matrix_user.inc"
+#    endif
+#    undef RGB_MATRIX_EFFECT
+#endif
+    // -----End rgb effect table macros-------------
+    // ---------------------------------------------
+};
+
 static void rgb_task_timers(void) {
 #if defined(RGB_MATRIX_KEYREACTIVE_ENABLED)
     uint32_t deltaTime = sync_timer_elapsed32(rgb_timer_buffer);
@@ -295,44 +490,18 @@ static void rgb_task_render(uint8_t effect) {
         rgb_matrix_set_color_all(0, 0, 0);
     }
 
+    // Factory default magic value
+    if (effect == UINT8_MAX) {
+        rgb_matrix_test();
+        rgb_task_state = FLUSHING;
+        return;
+    }
+
     // each effect can opt to do calculations
     // and/or request PWM buffer updates.
-    switch (effect) {
-        case RGB_MATRIX_NONE:
-            rendering = rgb_matrix_none(&rgb_effect_params);
-            break;
-
-// ---------------------------------------------
-// -----Begin rgb effect switch case macros-----
-#define RGB_MATRIX_EFFECT(name, ...)          \
-    case RGB_MATRIX_##name:                   \
-        rendering = name(&rgb_effect_params); \
-        break;
-#include "rgb_matrix_effects.inc"
-#undef RGB_MATRIX_EFFECT
-
-#if defined(RGB_MATRIX_CUSTOM_KB) || defined(RGB_MATRIX_CUSTOM_USER)
-#    define RGB_MATRIX_EFFECT(name, ...)          \
-        case RGB_MATRIX_CUSTOM_##name:            \
-            rendering = name(&rgb_effect_params); \
-            break;
-#    ifdef RGB_MATRIX_CUSTOM_KB
-#        include "rgb_matrix_kb.inc"
-#    endif
-#    ifdef RGB_MATRIX_CUSTOM_USER
-#        include "rgb_matrix_user.inc"
-#    endif
-#    undef RGB_MATRIX_EFFECT
-#endif
-            // -----End rgb effect switch case macros-------
-            // ---------------------------------------------
-
-        // Factory default magic value
-        case UINT8_MAX: {
-            rgb_matrix_test();
-            rgb_task_state = FLUSHING;
-        }
-            return;
+    if (effect < RGB_MATRIX_EFFECT_MAX) {
+        rgb_matrix_effect_f effect_func = (rgb_matrix_effect_f)pgm_read_ptr(&rgb_matrix_effect_funcs[effect]);
+        rendering                       = effect_func(&rgb_effect_params);
     }
 
     rgb_effect_params.iter++;
@@ -355,6 +524,10 @@ static void rgb_task_flush(uint8_t effect) {
     // update pwm buffers
     rgb_matrix_update_pwm_buffers();
 
+#ifdef RGB_MATRIX_CURRENT_BUDGET
+    rgb_matrix_current_update_scale();
+#endif
+
     // next task
     rgb_task_state = SYNCING;
 }
@@ -407,29 +580,13 @@ __attribute__((weak)) bool rgb_matrix_indicators_user(void) {
 }
 
 struct rgb_matrix_limits_t rgb_matrix_get_limits(uint8_t iter) {
-    struct rgb_matrix_limits_t limits = {0};
+    struct rgb_matrix_limits_t limits = rgb_matrix_get_local_limits();
 #if defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < RGB_MATRIX_LED_COUNT
-#    if defined(RGB_MATRIX_SPLIT)
-    limits.led_min_index = RGB_MATRIX_LED_PROCESS_LIMIT * (iter);
-    limits.led_max_index = limits.led_min_index + RGB_MATRIX_LED_PROCESS_LIMIT;
-    if (limits.led_max_index > RGB_MATRIX_LED_COUNT) limits.led_max_index = RGB_MATRIX_LED_COUNT;
-    if (is_keyboard_left() && (limits.led_max_index > k_rgb_matrix_split[0])) limits.led_max_index = k_rgb_matrix_split[0];
-    if (!(is_keyboard_left()) && (limits.led_min_index < k_rgb_matrix_split[0])) limits.led_min_index = k_rgb_matrix_split[0];
-#    else
-    limits.led_min_index = RGB_MATRIX_LED_PROCESS_LIMIT * (iter);
-    limits.led_max_index = limits.led_min_index + RGB_MATRIX_LED_PROCESS_LIMIT;
-    if (limits.led_max_index > RGB_MATRIX_LED_COUNT) limits.led_max_index = RGB_MATRIX_LED_COUNT;
-#    endif
-#else
-#    if defined(RGB_MATRIX_SPLIT)
-    limits.led_min_index = 0;
-    limits.led_max_index = RGB_MATRIX_LED_COUNT;
-    if (is_keyboard_left() && (limits.led_max_index > k_rgb_matrix_split[0])) limits.led_max_index = k_rgb_matrix_split[0];
-    if (!(is_keyboard_left()) && (limits.led_min_index < k_rgb_matrix_split[0])) limits.led_min_index = k_rgb_matrix_split[0];
-#    else
-    limits.led_min_index = 0;
-    limits.led_max_index = RGB_MATRIX_LED_COUNT;
-#    endif
+    // Chunks start at this half's first LED, so neither half spends iterations on the other's LEDs
+    uint8_t  local_max   = limits.led_max_index;
+    uint16_t led_max     = limits.led_min_index + RGB_MATRIX_LED_PROCESS_LIMIT * (iter + 1);
+    limits.led_min_index = limits.led_min_index + RGB_MATRIX_LED_PROCESS_LIMIT * (iter);
+    limits.led_max_index = led_max > local_max ? local_max : led_max;
 #endif
     return limits;
 }
@@ -454,6 +611,12 @@ __attribute__((weak)) bool rgb_matrix_indicators_advanced_user(uint8_t led_min,
 
 void rgb_matrix_init(void) {
     rgb_matrix_driver.init();
+#ifdef RGB_MATRIX_OUTPUT_LUT
+    rgb_matrix_output_lut_update();
+#endif // RGB_MATRIX_OUTPUT_LUT
+#ifdef RGB_MATRIX_CURRENT_BUDGET
+    rgb_matrix_current_budget_reset(false);
+#endif // RGB_MATRIX_CURRENT_BUDGET
 
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
     g_last_hit_tracker.count = 0;
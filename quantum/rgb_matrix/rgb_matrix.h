@@ -24,6 +24,9 @@
 #include "rgb_matrix_drivers.h"
 #include "color.h"
 #include "keyboard.h"
+#ifdef RGB_MATRIX_CURRENT_BUDGET
+#    include "usb_device_state.h"
+#endif
 
 #ifndef RGB_MATRIX_TIMEOUT
 #    define RGB_MATRIX_TIMEOUT 0
@@ -33,6 +36,32 @@
 #    define RGB_MATRIX_MAXIMUM_BRIGHTNESS UINT8_MAX
 #endif
 
+#ifdef RGB_MATRIX_OUTPUT_LUT
+#    ifndef RGB_MATRIX_WHITE_BALANCE
+#        define RGB_MATRIX_WHITE_BALANCE {UINT8_MAX, UINT8_MAX, UINT8_MAX}
+#    endif
+#    ifndef RGB_MATRIX_OUTPUT_LIMIT
+#        define RGB_MATRIX_OUTPUT_LIMIT UINT8_MAX
+#    endif
+#endif
+
+#ifdef RGB_MATRIX_CURRENT_BUDGET
+// Current drawn by each channel of an LED at full duty, in mA -- the defaults suit WS2812 style LEDs
+#    ifndef RGB_MATRIX_CURRENT_RED
+#        define RGB_MATRIX_CURRENT_RED 20
+#    endif
+#    ifndef RGB_MATRIX_CURRENT_GREEN
+#        define RGB_MATRIX_CURRENT_GREEN 20
+#    endif
+#    ifndef RGB_MATRIX_CURRENT_BLUE
+#        define RGB_MATRIX_CURRENT_BLUE 20
+#    endif
+// Budget in mA until the host has configured the device, which only guarantees 100mA in total
+#    ifndef RGB_MATRIX_CURRENT_BUDGET_UNCONFIGURED
+#        define RGB_MATRIX_CURRENT_BUDGET_UNCONFIGURED 50
+#    endif
+#endif
+
 #ifndef RGB_MATRIX_HUE_STEP
 #    define RGB_MATRIX_HUE_STEP 8
 #endif
@@ -90,6 +119,18 @@
 #    define RGB_MATRIX_LED_PROCESS_LIMIT ((RGB_MATRIX_LED_COUNT + 4) / 5)
 #endif
 
+#ifndef RGB_MATRIX_LED_FRAMEBUFFER_PLANES
+#    define RGB_MATRIX_LED_FRAMEBUFFER_PLANES 1
+#endif
+
+#ifndef RGB_MATRIX_LED_FRAMEBUFFER_NEIGHBORS
+#    define RGB_MATRIX_LED_FRAMEBUFFER_NEIGHBORS 4
+#endif
+
+#ifndef RGB_MATRIX_LED_FRAMEBUFFER_RADIUS
+#    define RGB_MATRIX_LED_FRAMEBUFFER_RADIUS 24
+#endif
+
 struct rgb_matrix_limits_t {
     uint8_t led_min_index;
     uint8_t led_max_index;
@@ -150,8 +191,32 @@ int rgb_matrix_led_index(int index);
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue);
 void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue);
 
+#ifdef RGB_MATRIX_OUTPUT_LUT
+void rgb_matrix_set_white_balance(uint8_t red, uint8_t green, uint8_t blue);
+void rgb_matrix_set_output_limit(uint8_t limit);
+#endif // RGB_MATRIX_OUTPUT_LUT
+
+#ifdef RGB_MATRIX_LED_FRAMEBUFFER_EFFECTS
+void rgb_matrix_led_frame_buffer_decay(uint8_t *plane, uint8_t amount);
+void rgb_matrix_led_frame_buffer_fade(uint8_t *plane, uint8_t scale);
+void rgb_matrix_led_frame_buffer_blur(uint8_t *plane, uint8_t amount);
+void rgb_matrix_led_frame_buffer_diffuse(uint8_t *plane, uint8_t amount);
+#endif // RGB_MATRIX_LED_FRAMEBUFFER_EFFECTS
+
+#ifdef RGB_MATRIX_CURRENT_BUDGET
+void     rgb_matrix_set_current_budget(uint16_t budget);
+uint16_t rgb_matrix_get_current_budget(void);
+uint16_t rgb_matrix_get_current_estimate(void);
+void     rgb_matrix_notify_usb_device_state_change(struct usb_device_state usb_device_state);
+#endif // RGB_MATRIX_CURRENT_BUDGET
+
 void rgb_matrix_handle_key_event(uint8_t row, uint8_t col, bool pressed);
 
+#if defined(RGB_MATRIX_KEYREACTIVE_ENABLED) && defined(RGB_MATRIX_SPLIT)
+const rgb_matrix_hit_events_t *rgb_matrix_get_hit_events(void);
+void                           rgb_matrix_apply_hit_events(const rgb_matrix_hit_events_t *events);
+#endif // defined(RGB_MATRIX_KEYREACTIVE_ENABLED) && defined(RGB_MATRIX_SPLIT)
+
 void rgb_matrix_task(void);
 
 // This runs after another backlight effect and replaces
@@ -280,3 +345,6 @@ extern last_hit_t g_last_hit_tracker;
 #ifdef RGB_MATRIX_FRAMEBUFFER_EFFECTS
 extern uint8_t g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS];
 #endif
+#ifdef RGB_MATRIX_LED_FRAMEBUFFER_EFFECTS
+extern uint8_t g_rgb_led_frame_buffer[RGB_MATRIX_LED_FRAMEBUFFER_PLANES][RGB_MATRIX_LED_COUNT];
+#endif
@@ -16,6 +16,10 @@
 
 #pragma once
 
+#ifdef __cplusplus
+#    define _Static_assert static_assert
+#endif
+
 #include <stdint.h>
 #include <stdbool.h>
 #include "color.h"
@@ -38,6 +42,19 @@ typedef struct PACKED {
     uint8_t  index[LED_HITS_TO_REMEMBER];
     uint16_t tick[LED_HITS_TO_REMEMBER];
 } last_hit_t;
+
+#    if defined(RGB_MATRIX_SPLIT)
+// Recent key hits sent from the master to the slave half
+#        ifndef RGB_MATRIX_SPLIT_HIT_EVENTS
+#            define RGB_MATRIX_SPLIT_HIT_EVENTS 4
+#        endif // RGB_MATRIX_SPLIT_HIT_EVENTS
+
+typedef struct PACKED {
+    uint8_t  seq;
+    uint8_t  index[RGB_MATRIX_SPLIT_HIT_EVENTS];
+    uint16_t tick[RGB_MATRIX_SPLIT_HIT_EVENTS];
+} rgb_matrix_hit_events_t;
+#    endif // RGB_MATRIX_SPLIT
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
 typedef enum rgb_task_states { STARTING, RENDERING, FLUSHING, SYNCING } rgb_task_states;
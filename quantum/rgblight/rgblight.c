@@ -123,6 +123,18 @@ static bool deferred_set_layer_state = false;
 
 rgblight_ranges_t rgblight_ranges = {0, RGBLIGHT_LED_COUNT, 0, RGBLIGHT_LED_COUNT, RGBLIGHT_LED_COUNT};
 
+#ifdef RGBLIGHT_SKIP_UNCHANGED_FLUSH
+// Last colour written to each LED, so rgblight_set() can skip the flush when a frame changes nothing
+static rgb_t rgblight_shadow[RGBLIGHT_LED_COUNT];
+static bool  rgblight_dirty = true;
+#endif
+
+#ifdef DEBUG_RGBLIGHT_FRAME_RATE
+static uint32_t rgblight_perf_task_count  = 0;
+static uint16_t rgblight_perf_frame_count = 0;
+static uint16_t rgblight_perf_flush_count = 0;
+#endif
+
 void rgblight_set_clipping_range(uint8_t start_pos, uint8_t num_leds) {
     rgblight_ranges.clipping_start_pos = start_pos;
     rgblight_ranges.clipping_num_leds  = num_leds;
@@ -149,7 +161,16 @@ uint8_t rgblight_led_index(uint8_t index) {
 }
 
 void setrgb(uint8_t r, uint8_t g, uint8_t b, int index) {
-    rgblight_driver.set_color(rgblight_led_index(index), r, g, b);
+    uint8_t led = rgblight_led_index(index);
+#ifdef RGBLIGHT_SKIP_UNCHANGED_FLUSH
+    rgb_t *shadow = &rgblight_shadow[led];
+    if (shadow->r == r && shadow->g == g && shadow->b == b) {
+        return;
+    }
+    *shadow        = (rgb_t){r, g, b};
+    rgblight_dirty = true;
+#endif
+    rgblight_driver.set_color(led, r, g, b);
 }
 
 void sethsv_raw(uint8_t hue, uint8_t sat, uint8_t val, int index) {
@@ -645,7 +666,7 @@ void rgblight_setrgb(uint8_t r, uint8_t g, uint8_t b) {
     }
 
     for (uint8_t i = rgblight_ranges.effect_start_pos; i < rgblight_ranges.effect_end_pos; i++) {
-        rgblight_driver.set_color(rgblight_led_index(i), r, g, b);
+        setrgb(r, g, b, i);
     }
     rgblight_set();
 }
@@ -655,7 +676,7 @@ void rgblight_setrgb_at(uint8_t r, uint8_t g, uint8_t b, uint8_t index) {
         return;
     }
 
-    rgblight_driver.set_color(rgblight_led_index(index), r, g, b);
+    setrgb(r, g, b, index);
     rgblight_set();
 }
 
@@ -686,7 +707,7 @@ void rgblight_setrgb_range(uint8_t r, uint8_t g, uint8_t b, uint8_t start, uint8
     }
 
     for (uint8_t i = start; i < end; i++) {
-        rgblight_driver.set_color(rgblight_led_index(i), r, g, b);
+        setrgb(r, g, b, i);
     }
     rgblight_set();
 }
@@ -878,7 +899,7 @@ void rgblight_wakeup(void) {
 void rgblight_set(void) {
     if (!rgblight_config.enable) {
         for (uint8_t i = rgblight_ranges.effect_start_pos; i < rgblight_ranges.effect_end_pos; i++) {
-            rgblight_driver.set_color(rgblight_led_index(i), 0, 0, 0);
+            setrgb(0, 0, 0, i);
         }
     }
 
@@ -894,6 +915,15 @@ void rgblight_set(void) {
     }
 #endif
 
+#ifdef RGBLIGHT_SKIP_UNCHANGED_FLUSH
+    if (!rgblight_dirty) {
+        return;
+    }
+    rgblight_dirty = false;
+#endif
+#ifdef DEBUG_RGBLIGHT_FRAME_RATE
+    rgblight_perf_flush_count++;
+#endif
     rgblight_driver.flush();
 }
 
@@ -997,77 +1027,80 @@ static void rgblight_effect_dummy(animation_status_t *anim) {
     **/
 }
 
-void rgblight_timer_task(void) {
-    if (rgblight_status.timer_enabled) {
-        effect_func_t effect_func   = rgblight_effect_dummy;
-        uint16_t      interval_time = 2000; // dummy interval
-        uint8_t       delta         = rgblight_config.mode - rgblight_status.base_mode;
-        animation_status.delta      = delta;
+// Finds the animation for the current mode, and how long each of its frames lasts
+static effect_func_t rgblight_effect_lookup(uint8_t delta, uint16_t *interval_time) {
+    effect_func_t effect_func = rgblight_effect_dummy;
+    *interval_time            = 2000; // dummy interval
 
-        // static light mode, do nothing here
-        if (1 == 0) { // dummy
-        }
+    // static light mode, do nothing here
+    if (1 == 0) { // dummy
+    }
 #    ifdef RGBLIGHT_EFFECT_BREATHING
-        else if (rgblight_status.base_mode == RGBLIGHT_MODE_BREATHING) {
-            // breathing mode
-            interval_time = get_interval_time(&RGBLED_BREATHING_INTERVALS[delta], 1, 100);
-            effect_func   = rgblight_effect_breathing;
-        }
+    else if (rgblight_status.base_mode == RGBLIGHT_MODE_BREATHING) {
+        // breathing mode
+        *interval_time = get_interval_time(&RGBLED_BREATHING_INTERVALS[delta], 1, 100);
+        effect_func    = rgblight_effect_breathing;
+    }
 #    endif
 #    ifdef RGBLIGHT_EFFECT_RAINBOW_MOOD
-        else if (rgblight_status.base_mode == RGBLIGHT_MODE_RAINBOW_MOOD) {
-            // rainbow mood mode
-            interval_time = get_interval_time(&RGBLED_RAINBOW_MOOD_INTERVALS[delta], 5, 100);
-            effect_func   = rgblight_effect_rainbow_mood;
-        }
+    else if (rgblight_status.base_mode == RGBLIGHT_MODE_RAINBOW_MOOD) {
+        // rainbow mood mode
+        *interval_time = get_interval_time(&RGBLED_RAINBOW_MOOD_INTERVALS[delta], 5, 100);
+        effect_func    = rgblight_effect_rainbow_mood;
+    }
 #    endif
 #    ifdef RGBLIGHT_EFFECT_RAINBOW_SWIRL
-        else if (rgblight_status.base_mode == RGBLIGHT_MODE_RAINBOW_SWIRL) {
-            // rainbow swirl mode
-            interval_time = get_interval_time(&RGBLED_RAINBOW_SWIRL_INTERVALS[delta / 2], 1, 100);
-            effect_func   = rgblight_effect_rainbow_swirl;
-        }
+    else if (rgblight_status.base_mode == RGBLIGHT_MODE_RAINBOW_SWIRL) {
+        // rainbow swirl mode
+        *interval_time = get_interval_time(&RGBLED_RAINBOW_SWIRL_INTERVALS[delta / 2], 1, 100);
+        effect_func    = rgblight_effect_rainbow_swirl;
+    }
 #    endif
 #    ifdef RGBLIGHT_EFFECT_SNAKE
-        else if (rgblight_status.base_mode == RGBLIGHT_MODE_SNAKE) {
-            // snake mode
-            interval_time = get_interval_time(&RGBLED_SNAKE_INTERVALS[delta / 2], 1, 200);
-            effect_func   = rgblight_effect_snake;
-        }
+    else if (rgblight_status.base_mode == RGBLIGHT_MODE_SNAKE) {
+        // snake mode
+        *interval_time = get_interval_time(&RGBLED_SNAKE_INTERVALS[delta / 2], 1, 200);
+        effect_func    = rgblight_effect_snake;
+    }
 #    endif
 #    ifdef RGBLIGHT_EFFECT_KNIGHT
-        else if (rgblight_status.base_mode == RGBLIGHT_MODE_KNIGHT) {
-            // knight mode
-            interval_time = get_interval_time(&RGBLED_KNIGHT_INTERVALS[delta], 5, 100);
-            effect_func   = rgblight_effect_knight;
-        }
+    else if (rgblight_status.base_mode == RGBLIGHT_MODE_KNIGHT) {
+        // knight mode
+        *interval_time = get_interval_time(&RGBLED_KNIGHT_INTERVALS[delta], 5, 100);
+        effect_func    = rgblight_effect_knight;
+    }
 #    endif
 #    ifdef RGBLIGHT_EFFECT_CHRISTMAS
-        else if (rgblight_status.base_mode == RGBLIGHT_MODE_CHRISTMAS) {
-            // christmas mode
-            interval_time = RGBLIGHT_EFFECT_CHRISTMAS_INTERVAL;
-            effect_func   = (effect_func_t)rgblight_effect_christmas;
-        }
+    else if (rgblight_status.base_mode == RGBLIGHT_MODE_CHRISTMAS) {
+        // christmas mode
+        *interval_time = RGBLIGHT_EFFECT_CHRISTMAS_INTERVAL;
+        effect_func    = (effect_func_t)rgblight_effect_christmas;
+    }
 #    endif
 #    ifdef RGBLIGHT_EFFECT_RGB_TEST
-        else if (rgblight_status.base_mode == RGBLIGHT_MODE_RGB_TEST) {
-            // RGB test mode
-            interval_time = pgm_read_word(&RGBLED_RGBTEST_INTERVALS[0]);
-            effect_func   = (effect_func_t)rgblight_effect_rgbtest;
-        }
+    else if (rgblight_status.base_mode == RGBLIGHT_MODE_RGB_TEST) {
+        // RGB test mode
+        *interval_time = pgm_read_word(&RGBLED_RGBTEST_INTERVALS[0]);
+        effect_func    = (effect_func_t)rgblight_effect_rgbtest;
+    }
 #    endif
 #    ifdef RGBLIGHT_EFFECT_ALTERNATING
-        else if (rgblight_status.base_mode == RGBLIGHT_MODE_ALTERNATING) {
-            interval_time = 500;
-            effect_func   = (effect_func_t)rgblight_effect_alternating;
-        }
+    else if (rgblight_status.base_mode == RGBLIGHT_MODE_ALTERNATING) {
+        *interval_time = 500;
+        effect_func    = (effect_func_t)rgblight_effect_alternating;
+    }
 #    endif
 #    ifdef RGBLIGHT_EFFECT_TWINKLE
-        else if (rgblight_status.base_mode == RGBLIGHT_MODE_TWINKLE) {
-            interval_time = get_interval_time(&RGBLED_TWINKLE_INTERVALS[delta % 3], 5, 30);
-            effect_func   = (effect_func_t)rgblight_effect_twinkle;
-        }
+    else if (rgblight_status.base_mode == RGBLIGHT_MODE_TWINKLE) {
+        *interval_time = get_interval_time(&RGBLED_TWINKLE_INTERVALS[delta % 3], 5, 30);
+        effect_func    = (effect_func_t)rgblight_effect_twinkle;
+    }
 #    endif
+    return effect_func;
+}
+
+void rgblight_timer_task(void) {
+    if (rgblight_status.timer_enabled) {
         if (animation_status.restart) {
             animation_status.restart    = false;
             animation_status.last_timer = sync_timer_read();
@@ -1075,6 +1108,10 @@ void rgblight_timer_task(void) {
         }
         uint16_t now = sync_timer_read();
         if (timer_expired(now, animation_status.last_timer)) {
+            uint16_t      interval_time;
+            uint8_t       delta       = rgblight_config.mode - rgblight_status.base_mode;
+            effect_func_t effect_func = rgblight_effect_lookup(delta, &interval_time);
+            animation_status.delta    = delta;
 #    if defined(RGBLIGHT_SPLIT) && !defined(RGBLIGHT_SPLIT_NO_ANIMATION_SYNC)
             static uint16_t report_last_timer = 0;
             static bool     tick_flag         = false;
@@ -1091,6 +1128,9 @@ void rgblight_timer_task(void) {
 #    endif
             animation_status.last_timer += interval_time;
             effect_func(&animation_status);
+#    ifdef DEBUG_RGBLIGHT_FRAME_RATE
+            rgblight_perf_frame_count++;
+#    endif
 #    if defined(RGBLIGHT_SPLIT) && !defined(RGBLIGHT_SPLIT_NO_ANIMATION_SYNC)
             if (animation_status.pos16 == 0 && oldpos16 != 0) {
                 tick_flag = true;
@@ -1215,7 +1255,7 @@ void rgblight_effect_snake(animation_status_t *anim) {
 #    endif
 
     for (i = 0; i < rgblight_ranges.effect_num_leds; i++) {
-        rgblight_driver.set_color(rgblight_led_index(i + rgblight_ranges.effect_start_pos), 0, 0, 0);
+        setrgb(0, 0, 0, i + rgblight_ranges.effect_start_pos);
 
         for (j = 0; j < RGBLIGHT_EFFECT_SNAKE_LENGTH; j++) {
             k = pos + j * increment;
@@ -1271,7 +1311,7 @@ void rgblight_effect_knight(animation_status_t *anim) {
 #    endif
     // Set all the LEDs to 0
     for (i = rgblight_ranges.effect_start_pos; i < rgblight_ranges.effect_end_pos; i++) {
-        rgblight_driver.set_color(rgblight_led_index(i), 0, 0, 0);
+        setrgb(0, 0, 0, i);
     }
     // Determine which LEDs should be lit up
     for (i = 0; i < RGBLIGHT_EFFECT_KNIGHT_LED_NUM; i++) {
@@ -1280,7 +1320,7 @@ void rgblight_effect_knight(animation_status_t *anim) {
         if (i >= low_bound && i <= high_bound) {
             sethsv(rgblight_config.hue, rgblight_config.sat, rgblight_config.val, cur);
         } else {
-            rgblight_driver.set_color(rgblight_led_index(cur), 0, 0, 0);
+            setrgb(0, 0, 0, cur);
         }
     }
     rgblight_set();
@@ -1452,6 +1492,45 @@ void rgblight_task(void) {
         rgblight_velocikey_decelerate();
     }
 #endif
+
+#ifdef DEBUG_RGBLIGHT_FRAME_RATE
+    static uint32_t perf_timer = 0;
+    rgblight_perf_task_count++;
+    if (timer_elapsed32(perf_timer) >= 1000) {
+        dprintf("rgblight: %u frames, %u flushes over %lu task calls\n", rgblight_perf_frame_count, rgblight_perf_flush_count, rgblight_perf_task_count);
+        perf_timer                = timer_read32();
+        rgblight_perf_task_count  = 0;
+        rgblight_perf_frame_count = 0;
+        rgblight_perf_flush_count = 0;
+    }
+#endif
+}
+
+uint16_t rgblight_time_to_next_frame(void) {
+    uint16_t next = UINT16_MAX;
+#ifdef RGBLIGHT_USE_TIMER
+    uint16_t now = sync_timer_read();
+    if (rgblight_status.timer_enabled) {
+        if (animation_status.restart || timer_expired(now, animation_status.last_timer)) {
+            return 0;
+        }
+        next = animation_status.last_timer - now;
+    }
+#    ifdef RGBLIGHT_LAYERS
+    if (deferred_set_layer_state) {
+        return 0;
+    }
+#        ifdef RGBLIGHT_LAYER_BLINK
+    if (_blinking_layer_mask != 0) {
+        if (timer_expired(now, _repeat_timer)) {
+            return 0;
+        }
+        next = MIN(next, (uint16_t)(_repeat_timer - now));
+    }
+#        endif
+#    endif
+#endif
+    return next;
 }
 
 #ifdef VELOCIKEY_ENABLE
@@ -388,6 +388,9 @@ void rgblight_show_solid_color(uint8_t r, uint8_t g, uint8_t b);
 void preprocess_rgblight(void);
 void rgblight_task(void);
 
+/* Milliseconds until rgblight_task() next has a frame to render, UINT16_MAX if nothing is animating */
+uint16_t rgblight_time_to_next_frame(void);
+
 #ifdef RGBLIGHT_USE_TIMER
 void rgblight_timer_init(void);
 void rgblight_timer_enable(void);
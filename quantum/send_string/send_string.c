@@ -23,6 +23,7 @@
 #include "keycode.h"
 #include "action.h"
 #include "wait.h"
+#include "timer.h"
 
 #if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
 #    include "audio.h"
@@ -292,6 +293,200 @@ void tap_random_base64(void) {
     }
 }
 
+#ifdef SEND_STRING_ASYNC_ENABLE
+#    ifdef DYNAMIC_KEYMAP_ENABLE
+#        include "dynamic_keymap.h"
+#    endif
+
+// Queued strings are stored back to back in a ring buffer, each as a header byte
+// holding the interval, followed by the string and its null terminator.
+static char     async_buffer[SEND_STRING_ASYNC_BUFFER_SIZE];
+static uint16_t async_head = 0;
+static uint16_t async_tail = 0;
+static uint16_t async_used = 0;
+
+// Key events still to be sent for the current character, one per task call.
+// The high bit of each entry marks a release.
+#    define ASYNC_RELEASE 0x8000
+static uint16_t async_events[8];
+static uint8_t  async_event_count = 0;
+static uint8_t  async_event_index = 0;
+static uint8_t  async_interval    = 0;
+static bool     async_in_string   = false;
+static uint16_t async_wait        = 0;
+static uint16_t async_timer       = 0;
+
+static bool send_string_async_enqueue(const char *string, uint8_t interval, bool progmem) {
+    uint16_t len = 0;
+    while (progmem ? pgm_read_byte(string + len) : string[len]) {
+        ++len;
+    }
+    // Header and terminator
+    if (len + 2 > SEND_STRING_ASYNC_BUFFER_SIZE - async_used) {
+        return false;
+    }
+
+    async_buffer[async_tail] = interval;
+    async_tail               = (async_tail + 1) % SEND_STRING_ASYNC_BUFFER_SIZE;
+    for (uint16_t i = 0; i <= len; ++i) {
+        async_buffer[async_tail] = progmem ? pgm_read_byte(string + i) : string[i];
+        async_tail               = (async_tail + 1) % SEND_STRING_ASYNC_BUFFER_SIZE;
+    }
+    async_used += len + 2;
+    return true;
+}
+
+static char send_string_async_pop(void) {
+    if (async_used == 0) {
+        return 0;
+    }
+    char c     = async_buffer[async_head];
+    async_head = (async_head + 1) % SEND_STRING_ASYNC_BUFFER_SIZE;
+    --async_used;
+    return c;
+}
+
+// Pops the next byte of a sequence, leaving the string's null terminator in
+// place if the sequence is cut short, so the next string isn't read into.
+static char send_string_async_pop_sequence(void) {
+    if (async_used == 0 || async_buffer[async_head] == 0) {
+        return 0;
+    }
+    return send_string_async_pop();
+}
+
+bool send_string_async(const char *string) {
+    return send_string_async_enqueue(string, TAP_CODE_DELAY, false);
+}
+
+bool send_string_async_with_delay(const char *string, uint8_t interval) {
+    return send_string_async_enqueue(string, interval, false);
+}
+
+#    if defined(__AVR__)
+bool send_string_async_P(const char *string) {
+    return send_string_async_enqueue(string, TAP_CODE_DELAY, true);
+}
+
+bool send_string_async_with_delay_P(const char *string, uint8_t interval) {
+    return send_string_async_enqueue(string, interval, true);
+}
+#    endif
+
+bool send_string_async_is_busy(void) {
+#    ifdef DYNAMIC_KEYMAP_ENABLE
+    if (dynamic_keymap_macro_send_is_pending()) {
+        return true;
+    }
+#    endif
+    return async_used > 0 || async_event_index < async_event_count;
+}
+
+// Translates the next character or sequence of the current string into key
+// events, mirroring send_string_with_delay() and send_char_with_delay().
+static void send_string_async_load_next(void) {
+    async_event_count = 0;
+    async_event_index = 0;
+
+    char ascii_code = send_string_async_pop();
+    if (!ascii_code) {
+        async_in_string = false;
+        return;
+    }
+
+    if (ascii_code == SS_QMK_PREFIX) {
+        ascii_code = send_string_async_pop_sequence();
+        if (ascii_code == SS_TAP_CODE) {
+            uint8_t keycode = send_string_async_pop_sequence();
+            if (keycode) {
+                async_events[async_event_count++] = keycode;
+                async_events[async_event_count++] = keycode | ASYNC_RELEASE;
+            }
+        } else if (ascii_code == SS_DOWN_CODE) {
+            uint8_t keycode = send_string_async_pop_sequence();
+            if (keycode) {
+                async_events[async_event_count++] = keycode;
+            }
+        } else if (ascii_code == SS_UP_CODE) {
+            uint8_t keycode = send_string_async_pop_sequence();
+            if (keycode) {
+                async_events[async_event_count++] = keycode | ASYNC_RELEASE;
+            }
+        } else if (ascii_code == SS_DELAY_CODE) {
+            uint16_t ms = 0;
+            // Digits are followed by '|', which is consumed here
+            while (isdigit(ascii_code = send_string_async_pop_sequence())) {
+                ms *= 10;
+                ms += ascii_code - '0';
+            }
+            async_wait = ms;
+        }
+        return;
+    }
+
+#    if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
+    if (ascii_code == '\a') { // BEL
+        PLAY_SONG(bell_song);
+        return;
+    }
+#    endif
+
+    uint8_t keycode    = pgm_read_byte(&ascii_to_keycode_lut[(uint8_t)ascii_code]);
+    bool    is_shifted = PGM_LOADBIT(ascii_to_shift_lut, (uint8_t)ascii_code);
+    bool    is_altgred = PGM_LOADBIT(ascii_to_altgr_lut, (uint8_t)ascii_code);
+    bool    is_dead    = PGM_LOADBIT(ascii_to_dead_lut, (uint8_t)ascii_code);
+
+    if (is_shifted) async_events[async_event_count++] = KC_LEFT_SHIFT;
+    if (is_altgred) async_events[async_event_count++] = KC_RIGHT_ALT;
+    async_events[async_event_count++] = keycode;
+    async_events[async_event_count++] = keycode | ASYNC_RELEASE;
+    if (is_altgred) async_events[async_event_count++] = KC_RIGHT_ALT | ASYNC_RELEASE;
+    if (is_shifted) async_events[async_event_count++] = KC_LEFT_SHIFT | ASYNC_RELEASE;
+    if (is_dead) {
+        async_events[async_event_count++] = KC_SPACE;
+        async_events[async_event_count++] = KC_SPACE | ASYNC_RELEASE;
+    }
+}
+
+void send_string_async_task(void) {
+#    ifdef DYNAMIC_KEYMAP_ENABLE
+    // Top up the queue with the next part of any VIA macro being sent
+    dynamic_keymap_macro_send_task();
+#    endif
+
+    // At most one key event is sent per call, so the rest of the main loop keeps running in between.
+    if (timer_elapsed(async_timer) < async_wait) {
+        return;
+    }
+    async_wait = 0;
+
+    while (async_event_index >= async_event_count) {
+        if (!async_in_string) {
+            if (async_used == 0) {
+                return;
+            }
+            async_interval  = send_string_async_pop();
+            async_in_string = true;
+        }
+        send_string_async_load_next();
+        if (async_wait) {
+            async_timer = timer_read();
+            async_wait += async_interval;
+            return;
+        }
+    }
+
+    uint16_t event = async_events[async_event_index++];
+    if (event & ASYNC_RELEASE) {
+        unregister_code(event & 0xFF);
+    } else {
+        register_code(event);
+    }
+    async_timer = timer_read();
+    async_wait  = async_interval;
+}
+#endif // SEND_STRING_ASYNC_ENABLE
+
 #if defined(__AVR__)
 void send_string_P(const char *string) {
     send_string_with_delay_P(string, TAP_CODE_DELAY);
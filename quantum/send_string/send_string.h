@@ -24,6 +24,7 @@
  */
 
 #include <stdint.h>
+#include <stdbool.h>
 
 #include "progmem.h"
 #include "send_string_keycodes.h"
@@ -161,4 +162,71 @@ void send_string_with_delay_P(const char *string, uint8_t interval);
  */
 #define SEND_STRING_DELAY(string, interval) send_string_with_delay_P(PSTR(string), interval)
 
+#if defined(SEND_STRING_ASYNC_ENABLE) || defined(__DOXYGEN__)
+#    ifndef SEND_STRING_ASYNC_BUFFER_SIZE
+#        define SEND_STRING_ASYNC_BUFFER_SIZE 128
+#    endif
+
+/**
+ * \brief Queue a string of ASCII characters to be typed out from the main loop.
+ *
+ * Unlike send_string(), this returns immediately. The string is copied into an internal buffer of
+ * `SEND_STRING_ASYNC_BUFFER_SIZE` bytes and typed out one key event per scan by send_string_async_task().
+ *
+ * \param string The string to type out.
+ *
+ * \return `false` if there was not enough room in the buffer, in which case nothing is queued.
+ */
+bool send_string_async(const char *string);
+
+/**
+ * \brief Queue a string of ASCII characters to be typed out from the main loop, with a delay between each key event.
+ *
+ * \param string The string to type out.
+ * \param interval The amount of time, in milliseconds, to wait before sending the next key event.
+ *
+ * \return `false` if there was not enough room in the buffer, in which case nothing is queued.
+ */
+bool send_string_async_with_delay(const char *string, uint8_t interval);
+
+#    if defined(__AVR__) || defined(__DOXYGEN__)
+/**
+ * \brief Queue a PROGMEM string of ASCII characters to be typed out from the main loop.
+ *
+ * On ARM devices, this function is simply an alias for send_string_async_with_delay(string, 0).
+ *
+ * \param string The string to type out.
+ */
+bool send_string_async_P(const char *string);
+
+/**
+ * \brief Queue a PROGMEM string of ASCII characters to be typed out from the main loop, with a delay between each key event.
+ *
+ * On ARM devices, this function is simply an alias for send_string_async_with_delay(string, interval).
+ *
+ * \param string The string to type out.
+ * \param interval The amount of time, in milliseconds, to wait before sending the next key event.
+ */
+bool send_string_async_with_delay_P(const char *string, uint8_t interval);
+#    else
+#        define send_string_async_P(string) send_string_async_with_delay(string, 0)
+#        define send_string_async_with_delay_P(string, interval) send_string_async_with_delay(string, interval)
+#    endif
+
+/**
+ * \brief Shortcut macro for send_string_async_with_delay_P(PSTR(string), 0).
+ */
+#    define SEND_STRING_ASYNC(string) send_string_async_with_delay_P(PSTR(string), 0)
+
+/**
+ * \brief Check whether queued strings are still being typed out.
+ */
+bool send_string_async_is_busy(void);
+
+/**
+ * \brief Send the next pending key event, if its delay has elapsed. Called from the main loop.
+ */
+void send_string_async_task(void);
+#endif
+
 /** \} */
@@ -579,21 +579,39 @@ static bool rgb_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_
     rgb_matrix_sync_t rgb_matrix_sync;
     memcpy(&rgb_matrix_sync.rgb_matrix, &rgb_matrix_config, sizeof(rgb_config_t));
     rgb_matrix_sync.rgb_suspend_state = rgb_matrix_get_suspend_state();
-    return send_if_data_mismatch(PUT_RGB_MATRIX, &last_update, &rgb_matrix_sync, &split_shmem->rgb_matrix_sync, sizeof(rgb_matrix_sync));
+    bool okay                         = send_if_data_mismatch(PUT_RGB_MATRIX, &last_update, &rgb_matrix_sync, &split_shmem->rgb_matrix_sync, sizeof(rgb_matrix_sync));
+#    ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+    if (okay) {
+        static uint32_t last_hits_update = 0;
+        okay &= send_if_data_mismatch(PUT_RGB_MATRIX_HITS, &last_hits_update, (void *)rgb_matrix_get_hit_events(), &split_shmem->rgb_matrix_hits, sizeof(rgb_matrix_hit_events_t));
+    }
+#    endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+    return okay;
 }
 
 static void rgb_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     split_shared_memory_lock();
     memcpy(&rgb_matrix_config, &split_shmem->rgb_matrix_sync.rgb_matrix, sizeof(rgb_config_t));
     bool rgb_suspend_state = split_shmem->rgb_matrix_sync.rgb_suspend_state;
+#    ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+    rgb_matrix_hit_events_t hit_events;
+    memcpy(&hit_events, &split_shmem->rgb_matrix_hits, sizeof(rgb_matrix_hit_events_t));
+#    endif // RGB_MATRIX_KEYREACTIVE_ENABLED
     split_shared_memory_unlock();
 
     rgb_matrix_set_suspend_state(rgb_suspend_state);
+#    ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+    rgb_matrix_apply_hit_events(&hit_events);
+#    endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 }
 
 #    define TRANSACTIONS_RGB_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(rgb_matrix)
 #    define TRANSACTIONS_RGB_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE(rgb_matrix)
-#    define TRANSACTIONS_RGB_MATRIX_REGISTRATIONS [PUT_RGB_MATRIX] = trans_initiator2target_initializer(rgb_matrix_sync),
+#    ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+#        define TRANSACTIONS_RGB_MATRIX_REGISTRATIONS [PUT_RGB_MATRIX] = trans_initiator2target_initializer(rgb_matrix_sync), [PUT_RGB_MATRIX_HITS] = trans_initiator2target_initializer(rgb_matrix_hits),
+#    else
+#        define TRANSACTIONS_RGB_MATRIX_REGISTRATIONS [PUT_RGB_MATRIX] = trans_initiator2target_initializer(rgb_matrix_sync),
+#    endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
 #else // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 
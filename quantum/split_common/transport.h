@@ -192,6 +192,9 @@ typedef struct _split_shared_memory_t {
 
 #if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
     rgb_matrix_sync_t rgb_matrix_sync;
+#    ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+    rgb_matrix_hit_events_t rgb_matrix_hits;
+#    endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 #endif // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 
 #if defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)
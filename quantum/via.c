@@ -273,8 +273,73 @@ __attribute__((weak)) void via_custom_value_command(uint8_t *data, uint8_t lengt
 // Controlling custom features should be done by overriding
 // via_custom_value_command_kb() instead.
 __attribute__((weak)) bool via_command_kb(uint8_t *data, uint8_t length) {
+#if defined(DYNAMIC_KEYMAP_BULK_ENABLE)
+    return via_dynamic_keymap_bulk_command(data, length);
+#else
     return false;
+#endif
+}
+
+#if defined(DYNAMIC_KEYMAP_BULK_ENABLE)
+#    ifndef DYNAMIC_KEYMAP_BULK_VIA_COMMAND_ID
+#        error DYNAMIC_KEYMAP_BULK_ENABLE requires DYNAMIC_KEYMAP_BULK_VIA_COMMAND_ID, a command id outside of the VIA protocol
+#    endif
+_Static_assert(DYNAMIC_KEYMAP_BULK_VIA_COMMAND_ID > id_dynamic_keymap_set_encoder && DYNAMIC_KEYMAP_BULK_VIA_COMMAND_ID < id_unhandled, "DYNAMIC_KEYMAP_BULK_VIA_COMMAND_ID must not be a VIA command id");
+
+bool via_dynamic_keymap_bulk_command(uint8_t *data, uint8_t length) {
+    // data = [ command_id, bulk_command_id, bulk_command_data ]
+    uint8_t *command_id        = &(data[0]);
+    uint8_t *bulk_command_id   = &(data[1]);
+    uint8_t *bulk_command_data = &(data[2]);
+
+    if (*command_id != DYNAMIC_KEYMAP_BULK_VIA_COMMAND_ID) {
+        return false;
+    }
+
+    switch (*bulk_command_id) {
+        case id_dynamic_keymap_bulk_get_info: {
+            // reply = [ version, window, packet_size ]
+            bulk_command_data[0] = DYNAMIC_KEYMAP_BULK_VERSION;
+            bulk_command_data[1] = DYNAMIC_KEYMAP_BULK_WINDOW;
+            bulk_command_data[2] = DYNAMIC_KEYMAP_BULK_PACKET_SIZE;
+            break;
+        }
+        case id_dynamic_keymap_bulk_begin: {
+            // data = [ region, offset (2), size (2) ]
+            // reply = [ region, offset (2), size (2), status ]
+            uint16_t offset      = (bulk_command_data[1] << 8) | bulk_command_data[2];
+            uint16_t size        = (bulk_command_data[3] << 8) | bulk_command_data[4];
+            bulk_command_data[5] = dynamic_keymap_bulk_begin(bulk_command_data[0], offset, size);
+            break;
+        }
+        case id_dynamic_keymap_bulk_write: {
+            // data = [ sequence (2), crc8, payload (27) ]
+            // reply = [ next sequence (2), status ]
+            // Every packet is answered, but only the end of each window is written
+            // to EEPROM, so a host may send a whole window before reading the answers.
+            uint16_t sequence    = (bulk_command_data[0] << 8) | bulk_command_data[1];
+            uint8_t  status      = dynamic_keymap_bulk_write(sequence, bulk_command_data[2], &bulk_command_data[3]);
+            sequence             = dynamic_keymap_bulk_get_sequence();
+            bulk_command_data[0] = sequence >> 8;
+            bulk_command_data[1] = sequence & 0xFF;
+            bulk_command_data[2] = status;
+            break;
+        }
+        case id_dynamic_keymap_bulk_commit: {
+            // reply = [ status ]
+            bulk_command_data[0] = dynamic_keymap_bulk_commit();
+            break;
+        }
+        default: {
+            *command_id = id_unhandled;
+            break;
+        }
+    }
+
+    raw_hid_send(data, length);
+    return true;
 }
+#endif // DYNAMIC_KEYMAP_BULK_ENABLE
 
 void raw_hid_receive(uint8_t *data, uint8_t length) {
     uint8_t *command_id   = &(data[0]);
@@ -96,6 +96,17 @@ enum via_command_id {
     id_unhandled                            = 0xFF,
 };
 
+// Bulk dynamic keymap transfers are not part of the VIA protocol, so they are
+// carried by a single keyboard level command id, handled in via_command_kb(),
+// which the keyboard must reserve with its host software:
+// data = [ DYNAMIC_KEYMAP_BULK_VIA_COMMAND_ID, bulk_command_id, bulk_command_data ]
+enum via_dynamic_keymap_bulk_command_id {
+    id_dynamic_keymap_bulk_get_info = 0x00,
+    id_dynamic_keymap_bulk_begin    = 0x01,
+    id_dynamic_keymap_bulk_write    = 0x02,
+    id_dynamic_keymap_bulk_commit   = 0x03,
+};
+
 enum via_keyboard_value_id {
     id_uptime              = 0x01,
     id_layout_options      = 0x02,
@@ -168,6 +179,12 @@ void via_set_device_indication(uint8_t value);
 // Called by QMK core to process VIA-specific keycodes.
 bool process_record_via(uint16_t keycode, keyrecord_t *record);
 
+#if defined(DYNAMIC_KEYMAP_BULK_ENABLE)
+// Called by the default via_command_kb(), keyboards which override it should
+// call this first to keep bulk transfers working.
+bool via_dynamic_keymap_bulk_command(uint8_t *data, uint8_t length);
+#endif
+
 // These are made external so that keyboard level custom value handlers can use them.
 #if defined(BACKLIGHT_ENABLE)
 void via_qmk_backlight_command(uint8_t *data, uint8_t length);
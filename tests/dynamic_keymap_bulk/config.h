@@ -0,0 +1,11 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define TRANSIENT_EEPROM_SIZE 512
+#define DYNAMIC_KEYMAP_LAYER_COUNT 2
+// Small enough for a transfer to span several windows
+#define DYNAMIC_KEYMAP_BULK_WINDOW 2
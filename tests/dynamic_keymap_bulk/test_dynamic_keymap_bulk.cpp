@@ -0,0 +1,161 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+
+extern "C" {
+#include "crc.h"
+}
+
+#define KEYMAP_SIZE (DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2)
+
+class DynamicKeymapBulk : public TestFixture {
+   public:
+    std::vector<uint8_t> pattern(uint16_t size, uint8_t seed) {
+        std::vector<uint8_t> data(size);
+        for (uint16_t i = 0; i < size; i++) {
+            data[i] = seed + i * 7;
+        }
+        return data;
+    }
+
+    // Sends packet `sequence` of `data`, with the CRC of its payload offset by `corrupt`
+    dynamic_keymap_bulk_status_t write(const std::vector<uint8_t>& data, uint16_t sequence, uint8_t corrupt = 0) {
+        uint8_t  packet[DYNAMIC_KEYMAP_BULK_PACKET_SIZE] = {0};
+        uint16_t offset                                  = sequence * DYNAMIC_KEYMAP_BULK_PACKET_SIZE;
+        uint8_t  length                                  = MIN(DYNAMIC_KEYMAP_BULK_PACKET_SIZE, (uint16_t)(data.size() - offset));
+        memcpy(packet, data.data() + offset, length);
+        return dynamic_keymap_bulk_write(sequence, crc8(packet, length) + corrupt, packet);
+    }
+
+    uint16_t packets(const std::vector<uint8_t>& data) {
+        return (data.size() + DYNAMIC_KEYMAP_BULK_PACKET_SIZE - 1) / DYNAMIC_KEYMAP_BULK_PACKET_SIZE;
+    }
+
+    std::vector<uint8_t> keymap(uint16_t offset, uint16_t size) {
+        std::vector<uint8_t> data(size);
+        dynamic_keymap_get_buffer(offset, size, data.data());
+        return data;
+    }
+
+    std::vector<uint8_t> macros(uint16_t offset, uint16_t size) {
+        std::vector<uint8_t> data(size);
+        dynamic_keymap_macro_get_buffer(offset, size, data.data());
+        return data;
+    }
+
+    uint8_t valid_flag() {
+        return macros(dynamic_keymap_macro_get_buffer_size() - 1, 1)[0];
+    }
+};
+
+TEST_F(DynamicKeymapBulk, InOrderTransferOverSeveralWindows) {
+    auto data = pattern(KEYMAP_SIZE, 1);
+    auto old  = keymap(0, KEYMAP_SIZE);
+    ASSERT_GT(packets(data), DYNAMIC_KEYMAP_BULK_WINDOW * 2);
+
+    EXPECT_EQ(dynamic_keymap_bulk_begin(DYNAMIC_KEYMAP_BULK_KEYMAP, 0, KEYMAP_SIZE), DYNAMIC_KEYMAP_BULK_OK);
+    for (uint16_t sequence = 0; sequence < packets(data); sequence++) {
+        bool window_end = (sequence + 1) % DYNAMIC_KEYMAP_BULK_WINDOW == 0 || sequence + 1 == packets(data);
+        EXPECT_EQ(write(data, sequence), window_end ? DYNAMIC_KEYMAP_BULK_OK : DYNAMIC_KEYMAP_BULK_PENDING);
+        EXPECT_EQ(dynamic_keymap_bulk_get_sequence(), sequence + 1);
+        // Nothing reaches EEPROM until the window is complete
+        if (!window_end) {
+            auto start = old.begin() + sequence * DYNAMIC_KEYMAP_BULK_PACKET_SIZE;
+            EXPECT_EQ(keymap(sequence * DYNAMIC_KEYMAP_BULK_PACKET_SIZE, DYNAMIC_KEYMAP_BULK_PACKET_SIZE), std::vector<uint8_t>(start, start + DYNAMIC_KEYMAP_BULK_PACKET_SIZE));
+        }
+    }
+    EXPECT_EQ(dynamic_keymap_bulk_commit(), DYNAMIC_KEYMAP_BULK_OK);
+    EXPECT_EQ(keymap(0, KEYMAP_SIZE), data);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 0), data[0] << 8 | data[1]);
+
+    // The transfer is closed once committed
+    EXPECT_EQ(dynamic_keymap_bulk_commit(), DYNAMIC_KEYMAP_BULK_ERROR_STATE);
+    EXPECT_EQ(write(data, 0), DYNAMIC_KEYMAP_BULK_ERROR_STATE);
+}
+
+TEST_F(DynamicKeymapBulk, RejectsTransfersOutOfRange) {
+    EXPECT_EQ(dynamic_keymap_bulk_begin(DYNAMIC_KEYMAP_BULK_KEYMAP, 1, KEYMAP_SIZE), DYNAMIC_KEYMAP_BULK_ERROR_RANGE);
+    EXPECT_EQ(dynamic_keymap_bulk_begin(DYNAMIC_KEYMAP_BULK_KEYMAP, 0, 0), DYNAMIC_KEYMAP_BULK_ERROR_RANGE);
+    EXPECT_EQ(dynamic_keymap_bulk_begin(2, 0, 1), DYNAMIC_KEYMAP_BULK_ERROR_RANGE);
+    EXPECT_EQ(dynamic_keymap_bulk_write(0, 0, NULL), DYNAMIC_KEYMAP_BULK_ERROR_STATE);
+}
+
+TEST_F(DynamicKeymapBulk, CrcFailureThenResend) {
+    auto data = pattern(KEYMAP_SIZE, 2);
+
+    EXPECT_EQ(dynamic_keymap_bulk_begin(DYNAMIC_KEYMAP_BULK_KEYMAP, 0, KEYMAP_SIZE), DYNAMIC_KEYMAP_BULK_OK);
+    EXPECT_EQ(write(data, 0), DYNAMIC_KEYMAP_BULK_PENDING);
+    EXPECT_EQ(write(data, 1, 1), DYNAMIC_KEYMAP_BULK_ERROR_CRC);
+    EXPECT_EQ(dynamic_keymap_bulk_get_sequence(), 1);
+
+    // Later packets are dropped until the bad one is resent
+    EXPECT_EQ(write(data, 2), DYNAMIC_KEYMAP_BULK_ERROR_SEQUENCE);
+    for (uint16_t sequence = dynamic_keymap_bulk_get_sequence(); sequence < packets(data); sequence++) {
+        EXPECT_NE(write(data, sequence), DYNAMIC_KEYMAP_BULK_ERROR_CRC);
+    }
+    EXPECT_EQ(dynamic_keymap_bulk_commit(), DYNAMIC_KEYMAP_BULK_OK);
+    EXPECT_EQ(keymap(0, KEYMAP_SIZE), data);
+}
+
+TEST_F(DynamicKeymapBulk, OutOfOrderSequence) {
+    auto data = pattern(KEYMAP_SIZE, 3);
+
+    EXPECT_EQ(dynamic_keymap_bulk_begin(DYNAMIC_KEYMAP_BULK_KEYMAP, 0, KEYMAP_SIZE), DYNAMIC_KEYMAP_BULK_OK);
+    EXPECT_EQ(write(data, 1), DYNAMIC_KEYMAP_BULK_ERROR_SEQUENCE);
+    EXPECT_EQ(dynamic_keymap_bulk_get_sequence(), 0);
+    EXPECT_EQ(write(data, 0), DYNAMIC_KEYMAP_BULK_PENDING);
+    // A repeated packet is out of sequence too
+    EXPECT_EQ(write(data, 0), DYNAMIC_KEYMAP_BULK_ERROR_SEQUENCE);
+    EXPECT_EQ(dynamic_keymap_bulk_get_sequence(), 1);
+
+    for (uint16_t sequence = 1; sequence < packets(data); sequence++) {
+        EXPECT_NE(write(data, sequence), DYNAMIC_KEYMAP_BULK_ERROR_SEQUENCE);
+    }
+    EXPECT_EQ(dynamic_keymap_bulk_commit(), DYNAMIC_KEYMAP_BULK_OK);
+    EXPECT_EQ(keymap(0, KEYMAP_SIZE), data);
+}
+
+TEST_F(DynamicKeymapBulk, CommitBeforeAllBytesArrive) {
+    auto data   = pattern(DYNAMIC_KEYMAP_BULK_PACKET_SIZE * 3, 'a');
+    data.back() = 0;
+
+    EXPECT_EQ(dynamic_keymap_bulk_begin(DYNAMIC_KEYMAP_BULK_MACROS, 0, data.size()), DYNAMIC_KEYMAP_BULK_OK);
+    EXPECT_EQ(valid_flag(), 0xFF);
+    EXPECT_EQ(write(data, 0), DYNAMIC_KEYMAP_BULK_PENDING);
+    EXPECT_EQ(write(data, 1), DYNAMIC_KEYMAP_BULK_OK);
+    EXPECT_EQ(dynamic_keymap_bulk_commit(), DYNAMIC_KEYMAP_BULK_ERROR_STATE);
+    // Macros stay disabled, and the transfer can still be finished
+    EXPECT_EQ(valid_flag(), 0xFF);
+    EXPECT_EQ(write(data, 2), DYNAMIC_KEYMAP_BULK_OK);
+    EXPECT_EQ(dynamic_keymap_bulk_commit(), DYNAMIC_KEYMAP_BULK_OK);
+    EXPECT_EQ(valid_flag(), 0);
+    EXPECT_EQ(macros(0, data.size()), data);
+}
+
+TEST_F(DynamicKeymapBulk, MacroTransferEndingOnValidFlag) {
+    uint16_t size   = dynamic_keymap_macro_get_buffer_size();
+    auto     data   = pattern(DYNAMIC_KEYMAP_BULK_PACKET_SIZE + 3, 'A');
+    uint16_t offset = size - data.size();
+    data.back()     = 0;
+
+    EXPECT_EQ(dynamic_keymap_bulk_begin(DYNAMIC_KEYMAP_BULK_MACROS, offset, data.size()), DYNAMIC_KEYMAP_BULK_OK);
+    EXPECT_EQ(write(data, 0), DYNAMIC_KEYMAP_BULK_PENDING);
+    EXPECT_EQ(write(data, 1), DYNAMIC_KEYMAP_BULK_OK);
+    // The window has been written, but the flag is held back until the commit
+    EXPECT_EQ(macros(offset, data.size() - 1), std::vector<uint8_t>(data.begin(), data.end() - 1));
+    EXPECT_EQ(valid_flag(), 0xFF);
+    EXPECT_EQ(dynamic_keymap_bulk_commit(), DYNAMIC_KEYMAP_BULK_OK);
+    EXPECT_EQ(valid_flag(), 0);
+    EXPECT_EQ(macros(offset, data.size()), data);
+
+    // A last byte which isn't a null leaves macros disabled, as with set_buffer
+    data.back() = 'z';
+    EXPECT_EQ(dynamic_keymap_bulk_begin(DYNAMIC_KEYMAP_BULK_MACROS, offset, data.size()), DYNAMIC_KEYMAP_BULK_OK);
+    EXPECT_EQ(write(data, 0), DYNAMIC_KEYMAP_BULK_PENDING);
+    EXPECT_EQ(write(data, 1), DYNAMIC_KEYMAP_BULK_OK);
+    EXPECT_EQ(dynamic_keymap_bulk_commit(), DYNAMIC_KEYMAP_BULK_OK);
+    EXPECT_EQ(valid_flag(), 'z');
+}
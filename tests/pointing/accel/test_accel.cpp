@@ -0,0 +1,108 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "mouse_report_util.hpp"
+#include "test_common.hpp"
+#include "test_pointing_device_driver.h"
+
+using testing::_;
+
+class PointingAccel : public TestFixture {};
+
+TEST_F(PointingAccel, CurveInterpolation) {
+    EXPECT_EQ(pointing_device_accel_get_factor(0), 128);
+    EXPECT_EQ(pointing_device_accel_get_factor(7), 128);
+    EXPECT_EQ(pointing_device_accel_get_factor(8), 128);
+    EXPECT_EQ(pointing_device_accel_get_factor(12), 320);
+    EXPECT_EQ(pointing_device_accel_get_factor(16), 512);
+    EXPECT_EQ(pointing_device_accel_get_factor(UINT16_MAX), 512);
+}
+
+TEST_F(PointingAccel, SlowMotionKeepsSubPixelRemainder) {
+    TestDriver driver;
+
+    // 0.5x at low speed, every second report carries a whole count
+    pd_set_x(1);
+    EXPECT_NO_MOUSE_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_MOUSE_REPORT(driver, (1, 0, 0, 0, 0));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    pd_set_x(-3);
+    EXPECT_MOUSE_REPORT(driver, (-1, 0, 0, 0, 0));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_MOUSE_REPORT(driver, (-2, 0, 0, 0, 0));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    pd_clear_movement();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PointingAccel, DirectionChangeDropsRemainder) {
+    TestDriver driver;
+
+    pd_set_y(1);
+    EXPECT_NO_MOUSE_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // the half count left over from moving down must not cancel the first half count up
+    pd_set_y(-1);
+    EXPECT_NO_MOUSE_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_MOUSE_REPORT(driver, (0, -1, 0, 0, 0));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    pd_clear_movement();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PointingAccel, FastMotionIsAccelerated) {
+    TestDriver driver;
+
+    pd_set_x(12);
+    EXPECT_MOUSE_REPORT(driver, (15, 0, 0, 0, 0));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    pd_set_x(16);
+    EXPECT_MOUSE_REPORT(driver, (32, 0, 0, 0, 0));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // diagonal speed is approximated as 8 + 8 / 2
+    pd_set_x(8);
+    pd_set_y(8);
+    EXPECT_MOUSE_REPORT(driver, (10, 10, 0, 0, 0));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    pd_clear_movement();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PointingAccel, OutputIsClamped) {
+    TestDriver driver;
+
+    pd_set_x(100);
+    EXPECT_MOUSE_REPORT(driver, (XY_REPORT_MAX, 0, 0, 0, 0));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    pd_clear_movement();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,27 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+// The optional rgb_matrix features, on the same 4x10 LED layout as the parent folder
+#define RGB_MATRIX_LED_COUNT 40
+
+#define RGB_MATRIX_KEYPRESSES
+#define RGB_MATRIX_FRAMEBUFFER_EFFECTS
+
+#define RGB_MATRIX_LED_FRAMEBUFFER_EFFECTS
+// Keys are 25 apart horizontally on the test grid, so this makes the four next to each LED its neighbours
+#define RGB_MATRIX_LED_FRAMEBUFFER_RADIUS 32
+#define RGB_MATRIX_SPLASH_DISTANCE_CACHE
+#define RGB_MATRIX_TYPING_HEATMAP_SPREAD_CACHE
+#define RGB_MATRIX_OUTPUT_LUT
+#define RGB_MATRIX_CURRENT_BUDGET 400
+
+// The effects which use the caches above
+#define ENABLE_RGB_MATRIX_TYPING_HEATMAP
+#define ENABLE_RGB_MATRIX_SPLASH
+#define ENABLE_RGB_MATRIX_MULTISPLASH
+#define ENABLE_RGB_MATRIX_SOLID_SPLASH
+#define ENABLE_RGB_MATRIX_SOLID_MULTISPLASH
@@ -0,0 +1,175 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "rgb_matrix_sim_driver.h"
+#include "led_tables.h"
+
+void advance_time(uint32_t ms);
+
+static bool keyboard_master = true;
+
+bool is_keyboard_master(void) {
+    return keyboard_master;
+}
+}
+
+namespace {
+
+class RgbMatrixOptional : public TestFixture {
+   protected:
+    void SetUp() override {
+        keyboard_master = true;
+        rgb_matrix_set_current_budget(UINT16_MAX);
+        rgb_matrix_enable_noeeprom();
+        rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_COLOR);
+    }
+
+    // Runs rgb_matrix until it has flushed one complete frame
+    void render_frame() {
+        uint32_t flushes = rgb_matrix_sim_get_flush_count();
+        advance_time(RGB_MATRIX_LED_FLUSH_LIMIT);
+        for (int task = 0; task < RGB_MATRIX_LED_COUNT + 4 && rgb_matrix_sim_get_flush_count() == flushes; task++) {
+            rgb_matrix_task();
+        }
+        ASSERT_NE(rgb_matrix_sim_get_flush_count(), flushes) << "frame did not finish";
+    }
+};
+
+TEST_F(RgbMatrixOptional, RenderCachedEffects) {
+    const uint8_t modes[] = {RGB_MATRIX_TYPING_HEATMAP, RGB_MATRIX_SPLASH, RGB_MATRIX_MULTISPLASH, RGB_MATRIX_SOLID_SPLASH, RGB_MATRIX_SOLID_MULTISPLASH};
+
+    rgb_matrix_sethsv_noeeprom(HSV_RED);
+    for (uint8_t mode : modes) {
+        rgb_matrix_mode_noeeprom(mode);
+        for (unsigned frame = 0; frame < 64; frame++) {
+            if (frame % 8 == 0) {
+                rgb_matrix_handle_key_event((frame / 8) % MATRIX_ROWS, (frame * 3) % MATRIX_COLS, true);
+                rgb_matrix_handle_key_event((frame / 8) % MATRIX_ROWS, (frame * 3) % MATRIX_COLS, false);
+            }
+            render_frame();
+        }
+    }
+    EXPECT_EQ(rgb_matrix_sim_get_invalid_writes(), 0);
+}
+
+TEST_F(RgbMatrixOptional, DiffuseConservesTotal) {
+    uint8_t* plane = g_rgb_led_frame_buffer[0];
+    memset(plane, 0, RGB_MATRIX_LED_COUNT);
+    plane[0]  = 100;
+    plane[15] = 200;
+    plane[39] = 60;
+
+    for (int step = 0; step < 16; step++) {
+        rgb_matrix_led_frame_buffer_diffuse(plane, 128);
+
+        unsigned total = 0;
+        for (int i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+            total += plane[i];
+        }
+        EXPECT_EQ(total, 360) << "after step " << step;
+    }
+
+    // and it has actually spread out from where it started, in both directions
+    EXPECT_LT(plane[15], 200);
+    EXPECT_GT(plane[14], 0);
+    EXPECT_GT(plane[25], 0);
+}
+
+TEST_F(RgbMatrixOptional, OutputLutIsIdentityByDefault) {
+    // Raw writes, as from indicators, are passed through untouched
+    for (int value = 0; value < 256; value++) {
+        rgb_matrix_set_color(0, value, 255 - value, value / 2);
+        rgb_matrix_driver.flush();
+        EXPECT_EQ(rgb_matrix_sim_frame[0].r, value);
+        EXPECT_EQ(rgb_matrix_sim_frame[0].g, 255 - value);
+        EXPECT_EQ(rgb_matrix_sim_frame[0].b, value / 2);
+    }
+}
+
+// rgb_matrix builds always enable CIE1931_CURVE
+TEST_F(RgbMatrixOptional, OutputLutKeepsGammaOnValue) {
+    for (int value = 0; value < 256; value += 15) {
+        rgb_matrix_sethsv_noeeprom(0, 0, value);
+        render_frame();
+        EXPECT_EQ(rgb_matrix_sim_frame[0].r, pgm_read_byte(&CIE1931_CURVE[value])) << "value " << value;
+        EXPECT_EQ(rgb_matrix_sim_frame[0].g, pgm_read_byte(&CIE1931_CURVE[value])) << "value " << value;
+        EXPECT_EQ(rgb_matrix_sim_frame[0].b, pgm_read_byte(&CIE1931_CURVE[value])) << "value " << value;
+    }
+
+    // Mixed hues come out as they do without the tables, gamma on each channel would make this redder
+    rgb_matrix_sethsv_noeeprom(21, 255, 160);
+    render_frame();
+    rgb_t expected = hsv_to_rgb(rgb_matrix_get_hsv());
+    EXPECT_EQ(rgb_matrix_sim_frame[0].r, expected.r);
+    EXPECT_EQ(rgb_matrix_sim_frame[0].g, expected.g);
+    EXPECT_EQ(rgb_matrix_sim_frame[0].b, expected.b);
+}
+
+TEST_F(RgbMatrixOptional, OutputLutAppliesWhiteBalance) {
+    rgb_matrix_set_white_balance(255, 127, 63);
+    rgb_matrix_sethsv_noeeprom(HSV_WHITE);
+    render_frame();
+    rgb_matrix_set_white_balance(255, 255, 255);
+
+    EXPECT_EQ(rgb_matrix_sim_frame[0].r, 255);
+    EXPECT_EQ(rgb_matrix_sim_frame[0].g, 127);
+    EXPECT_EQ(rgb_matrix_sim_frame[0].b, 63);
+}
+
+TEST_F(RgbMatrixOptional, CurrentLimiterScalesToBudget) {
+    rgb_matrix_set_current_budget(400);
+    rgb_matrix_sethsv_noeeprom(HSV_WHITE);
+
+    // 40 LEDs at 3x20mA each want 2400mA, which only shows up once the first frame has been drawn
+    render_frame();
+    render_frame();
+    EXPECT_EQ(rgb_matrix_get_current_estimate(), 2400);
+
+    // 400/2400 of full brightness, in 1/256 steps
+    for (int i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        EXPECT_EQ(rgb_matrix_sim_frame[i].r, 255 * 42 / 256) << "LED " << i;
+        EXPECT_EQ(rgb_matrix_sim_frame[i].g, 255 * 42 / 256) << "LED " << i;
+        EXPECT_EQ(rgb_matrix_sim_frame[i].b, 255 * 42 / 256) << "LED " << i;
+    }
+}
+
+TEST_F(RgbMatrixOptional, CurrentLimiterLeavesFrameWithinBudgetAlone) {
+    rgb_matrix_set_current_budget(400);
+    rgb_matrix_sethsv_noeeprom(0, 0, 100);
+
+    render_frame();
+    render_frame();
+    EXPECT_LE(rgb_matrix_get_current_estimate(), 400);
+    for (int i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        EXPECT_EQ(rgb_matrix_sim_frame[i].r, pgm_read_byte(&CIE1931_CURVE[100])) << "LED " << i;
+    }
+}
+
+TEST_F(RgbMatrixOptional, CurrentBudgetFollowsUsbState) {
+    struct usb_device_state state = {};
+    state.configure_state         = USB_DEVICE_STATE_CONFIGURED;
+    rgb_matrix_notify_usb_device_state_change(state);
+    EXPECT_EQ(rgb_matrix_get_current_budget(), RGB_MATRIX_CURRENT_BUDGET);
+
+    state.configure_state = USB_DEVICE_STATE_SUSPEND;
+    rgb_matrix_notify_usb_device_state_change(state);
+    EXPECT_EQ(rgb_matrix_get_current_budget(), RGB_MATRIX_CURRENT_BUDGET_UNCONFIGURED);
+}
+
+TEST_F(RgbMatrixOptional, CurrentBudgetIsFullOnSlave) {
+    keyboard_master = false;
+
+    struct usb_device_state state = {};
+    state.configure_state         = USB_DEVICE_STATE_INIT;
+    rgb_matrix_notify_usb_device_state_change(state);
+    EXPECT_EQ(rgb_matrix_get_current_budget(), RGB_MATRIX_CURRENT_BUDGET);
+
+    rgb_matrix_init();
+    EXPECT_EQ(rgb_matrix_get_current_budget(), RGB_MATRIX_CURRENT_BUDGET);
+}
+
+} // namespace
@@ -0,0 +1,48 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "rgb_matrix.h"
+#include "rgb_matrix_sim_driver.h"
+
+rgb_t rgb_matrix_sim_frame[RGB_MATRIX_LED_COUNT];
+
+static rgb_t    buffer[RGB_MATRIX_LED_COUNT];
+static uint32_t flush_count    = 0;
+static uint32_t invalid_writes = 0;
+
+static void init(void) {}
+
+static void set_color(int index, uint8_t r, uint8_t g, uint8_t b) {
+    if (index < 0 || index >= RGB_MATRIX_LED_COUNT) {
+        invalid_writes++;
+        return;
+    }
+    buffer[index] = (rgb_t){.r = r, .g = g, .b = b};
+}
+
+static void set_color_all(uint8_t r, uint8_t g, uint8_t b) {
+    for (int i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        set_color(i, r, g, b);
+    }
+}
+
+static void flush(void) {
+    memcpy(rgb_matrix_sim_frame, buffer, sizeof(buffer));
+    flush_count++;
+}
+
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = init,
+    .set_color     = set_color,
+    .set_color_all = set_color_all,
+    .flush         = flush,
+};
+
+uint32_t rgb_matrix_sim_get_flush_count(void) {
+    return flush_count;
+}
+
+uint32_t rgb_matrix_sim_get_invalid_writes(void) {
+    return invalid_writes;
+}
@@ -0,0 +1,13 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include "color.h"
+
+// The colours most recently flushed by rgb_matrix
+extern rgb_t rgb_matrix_sim_frame[RGB_MATRIX_LED_COUNT];
+
+uint32_t rgb_matrix_sim_get_flush_count(void);
+uint32_t rgb_matrix_sim_get_invalid_writes(void);
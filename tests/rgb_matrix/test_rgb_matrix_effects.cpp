@@ -0,0 +1,107 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "rgb_matrix_sim_driver.h"
+
+void advance_time(uint32_t ms);
+}
+
+// Renders every enabled effect against the simulated driver, checking that each one completes its frames.
+//
+// QMK_RGB_MATRIX_FRAMES     number of frames to render per effect (default 64)
+// QMK_RGB_MATRIX_BENCHMARK  when set, prints the host time spent rendering each effect
+// QMK_RGB_MATRIX_FRAMES_DIR when set, writes every frame to this directory as <mode>_<frame>.ppm
+namespace {
+
+constexpr int kPixelScale = 4;
+constexpr int kLedSize    = 9;
+
+unsigned env_or(const char* name, unsigned fallback) {
+    const char* value = std::getenv(name);
+    return value ? std::strtoul(value, nullptr, 10) : fallback;
+}
+
+void write_frame(const std::string& dir, uint8_t mode, unsigned frame) {
+    constexpr int width  = 225 * kPixelScale;
+    constexpr int height = 65 * kPixelScale;
+    static uint8_t image[height][width][3];
+    memset(image, 0, sizeof(image));
+
+    for (int i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        int cx = g_led_config.point[i].x * kPixelScale;
+        int cy = g_led_config.point[i].y * kPixelScale;
+        for (int y = cy - kLedSize * kPixelScale / 2; y <= cy + kLedSize * kPixelScale / 2; y++) {
+            for (int x = cx - kLedSize * kPixelScale / 2; x <= cx + kLedSize * kPixelScale / 2; x++) {
+                if (x < 0 || x >= width || y < 0 || y >= height) continue;
+                image[y][x][0] = rgb_matrix_sim_frame[i].r;
+                image[y][x][1] = rgb_matrix_sim_frame[i].g;
+                image[y][x][2] = rgb_matrix_sim_frame[i].b;
+            }
+        }
+    }
+
+    char name[32];
+    snprintf(name, sizeof(name), "/%02u_%04u.ppm", mode, frame);
+    FILE* file = fopen((dir + name).c_str(), "wb");
+    ASSERT_NE(file, nullptr) << "could not write to " << dir;
+    fprintf(file, "P6\n%d %d\n255\n", width, height);
+    fwrite(image, sizeof(image), 1, file);
+    fclose(file);
+}
+
+class RgbMatrixEffects : public TestFixture {};
+
+TEST_F(RgbMatrixEffects, RenderEveryEffect) {
+    const unsigned frames     = env_or("QMK_RGB_MATRIX_FRAMES", 64);
+    const bool     benchmark  = std::getenv("QMK_RGB_MATRIX_BENCHMARK") != nullptr;
+    const char*    frames_dir = std::getenv("QMK_RGB_MATRIX_FRAMES_DIR");
+
+    rgb_matrix_enable_noeeprom();
+    rgb_matrix_sethsv_noeeprom(HSV_RED);
+    rgb_matrix_set_speed_noeeprom(RGB_MATRIX_DEFAULT_SPD);
+
+    for (uint8_t mode = RGB_MATRIX_SOLID_COLOR; mode < RGB_MATRIX_EFFECT_MAX; mode++) {
+        rgb_matrix_mode_noeeprom(mode);
+
+        std::chrono::nanoseconds elapsed{0};
+        for (unsigned frame = 0; frame < frames; frame++) {
+            // Give the reactive effects something to react to
+            if (frame % 16 == 0) {
+                rgb_matrix_handle_key_event((frame / 16) % MATRIX_ROWS, (frame * 3) % MATRIX_COLS, true);
+                rgb_matrix_handle_key_event((frame / 16) % MATRIX_ROWS, (frame * 3) % MATRIX_COLS, false);
+            }
+
+            uint32_t flushes = rgb_matrix_sim_get_flush_count();
+            advance_time(RGB_MATRIX_LED_FLUSH_LIMIT);
+
+            auto start = std::chrono::steady_clock::now();
+            for (int task = 0; task < RGB_MATRIX_LED_COUNT + 4 && rgb_matrix_sim_get_flush_count() == flushes; task++) {
+                rgb_matrix_task();
+            }
+            elapsed += std::chrono::steady_clock::now() - start;
+
+            ASSERT_NE(rgb_matrix_sim_get_flush_count(), flushes) << "mode " << +mode << " did not finish frame " << frame;
+            if (frames_dir) {
+                write_frame(frames_dir, mode, frame);
+            }
+        }
+
+        EXPECT_EQ(rgb_matrix_sim_get_invalid_writes(), 0) << "mode " << +mode << " wrote to a LED which doesn't exist";
+
+        if (benchmark) {
+            double per_frame = (double)elapsed.count() / frames;
+            printf("mode %2u: %9.0f ns/frame %7.1f ns/LED\n", mode, per_frame, per_frame / RGB_MATRIX_LED_COUNT);
+        }
+    }
+}
+
+} // namespace
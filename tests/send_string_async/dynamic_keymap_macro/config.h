@@ -0,0 +1,13 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define SEND_STRING_ASYNC_ENABLE
+// Small enough for a macro to span several windows
+#define SEND_STRING_ASYNC_BUFFER_SIZE 16
+
+#define TRANSIENT_EEPROM_SIZE 512
+#define DYNAMIC_KEYMAP_LAYER_COUNT 2
@@ -0,0 +1,11 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# --------------------------------------------------------------------------------
+# Keep this file, even if it is empty, as a marker that this folder contains tests
+# --------------------------------------------------------------------------------
+
+SEND_STRING_ENABLE = yes
+DYNAMIC_KEYMAP_ENABLE = yes
+# The test harness EEPROM is too small for dynamic keymaps
+EEPROM_DRIVER = transient
@@ -0,0 +1,90 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class DynamicKeymapMacroAsync : public TestFixture {
+   public:
+    // Expects `s`, lowercase letters only, to be typed out one key event per report
+    void ExpectTyped(TestDriver& driver, const std::string& s) {
+        InSequence seq;
+        for (char c : s) {
+            EXPECT_REPORT(driver, (KC_A + c - 'a'));
+            EXPECT_EMPTY_REPORT(driver);
+        }
+    }
+
+    // Stores `macros` back to back, each with its null terminator
+    void set_macros(const std::vector<std::string>& macros) {
+        std::string buffer;
+        for (const auto& macro : macros) {
+            buffer += macro;
+            buffer += '\0';
+        }
+        dynamic_keymap_macro_reset();
+        dynamic_keymap_macro_set_buffer(0, buffer.size(), (uint8_t*)buffer.data());
+    }
+
+    void drain() {
+        for (int i = 0; i < 500 && send_string_async_is_busy(); i++) {
+            run_one_scan_loop();
+        }
+        EXPECT_FALSE(send_string_async_is_busy());
+    }
+};
+
+TEST_F(DynamicKeymapMacroAsync, LongMacroDoesNotBlock) {
+    TestDriver  driver;
+    std::string macro;
+    for (int i = 0; i < 60; i++) {
+        macro += 'a' + i % 26;
+    }
+    set_macros({macro});
+
+    // Far longer than the queue, but nothing is typed until the main loop runs
+    EXPECT_NO_REPORT(driver);
+    dynamic_keymap_macro_send(0);
+    EXPECT_TRUE(send_string_async_is_busy());
+    VERIFY_AND_CLEAR(driver);
+
+    ExpectTyped(driver, macro);
+    drain();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicKeymapMacroAsync, SequencesAcrossWindows) {
+    TestDriver  driver;
+    std::string macro;
+    std::string typed;
+    for (int i = 0; i < 6; i++) {
+        macro += "ab" SS_TAP(X_C);
+        typed += "abc";
+    }
+    set_macros({macro});
+
+    ExpectTyped(driver, typed);
+    dynamic_keymap_macro_send(0);
+    drain();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicKeymapMacroAsync, MacrosAreTypedInOrder) {
+    TestDriver driver;
+    set_macros({"abcdefghijklmnopqrstu", "xyz"});
+
+    ExpectTyped(driver, "abcdefghijklmnopqrstuxyzabcdefghijklmnopqrstu");
+    dynamic_keymap_macro_send(0);
+    dynamic_keymap_macro_send(1);
+    // Queued behind both macros, not between their windows
+    run_one_scan_loop();
+    dynamic_keymap_macro_send(0);
+    drain();
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,129 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class SendStringAsync : public TestFixture {
+   public:
+    // Expects `s`, lowercase letters only, to be typed out one key event per report
+    void ExpectTyped(TestDriver& driver, const std::string& s) {
+        InSequence seq;
+        for (char c : s) {
+            EXPECT_REPORT(driver, (KC_A + c - 'a'));
+            EXPECT_EMPTY_REPORT(driver);
+        }
+    }
+
+    void drain() {
+        for (int i = 0; i < 100 && send_string_async_is_busy(); i++) {
+            run_one_scan_loop();
+        }
+        EXPECT_FALSE(send_string_async_is_busy());
+    }
+};
+
+TEST_F(SendStringAsync, ReturnsBeforeTyping) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    EXPECT_TRUE(send_string_async("abc"));
+    EXPECT_TRUE(send_string_async_is_busy());
+    VERIFY_AND_CLEAR(driver);
+
+    // One key event per scan
+    ExpectTyped(driver, "abc");
+    idle_for(6);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_FALSE(send_string_async_is_busy());
+}
+
+TEST_F(SendStringAsync, InterleavesWithTyping) {
+    TestDriver driver;
+    auto       key_x = KeymapKey(0, 0, 0, KC_X);
+    set_keymap({key_x});
+
+    EXPECT_TRUE(send_string_async("ab"));
+
+    // The physical key is processed first, and stays held around the queued string
+    {
+        InSequence seq;
+        EXPECT_REPORT(driver, (KC_X));
+        EXPECT_REPORT(driver, (KC_X, KC_A));
+        EXPECT_REPORT(driver, (KC_X));
+        EXPECT_REPORT(driver, (KC_X, KC_B));
+        EXPECT_REPORT(driver, (KC_X));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    key_x.press();
+    idle_for(4);
+    key_x.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, DelayDoesNotBlock) {
+    TestDriver driver;
+
+    EXPECT_TRUE(send_string_async("a" SS_DELAY(20) "b"));
+
+    ExpectTyped(driver, "a");
+    idle_for(2);
+    VERIFY_AND_CLEAR(driver);
+
+    // Scans keep running while the delay elapses
+    EXPECT_NO_REPORT(driver);
+    idle_for(15);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_TRUE(send_string_async_is_busy());
+
+    ExpectTyped(driver, "b");
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_FALSE(send_string_async_is_busy());
+}
+
+TEST_F(SendStringAsync, FullQueueRejectsString) {
+    TestDriver driver;
+
+    // Each string takes its length plus two bytes of the 16 byte buffer
+    EXPECT_TRUE(send_string_async("abcdefgh"));
+    EXPECT_FALSE(send_string_async("abcde"));
+    EXPECT_TRUE(send_string_async("abcd"));
+    EXPECT_FALSE(send_string_async("a"));
+
+    ExpectTyped(driver, "abcdefghabcd");
+    drain();
+    VERIFY_AND_CLEAR(driver);
+
+    // and there is room again once it has all been typed
+    ExpectTyped(driver, "xyz");
+    EXPECT_TRUE(send_string_async("xyz"));
+    drain();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, TruncatedSequenceStopsAtEndOfString) {
+    TestDriver driver;
+
+    // A prefix, a tap with no keycode, and a delay with no '|', each cut short by the end of their string
+    EXPECT_TRUE(send_string_async("a\1"));
+    EXPECT_TRUE(send_string_async("b\1\1"));
+    EXPECT_TRUE(send_string_async("c\1\4" "1"));
+
+    ExpectTyped(driver, "abc");
+    drain();
+    VERIFY_AND_CLEAR(driver);
+
+    // Nothing is left behind to be typed later
+    EXPECT_NO_REPORT(driver);
+    idle_for(20);
+    VERIFY_AND_CLEAR(driver);
+}
@@ -24,6 +24,10 @@
 #    include "os_detection.h"
 #endif
 
+#if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_CURRENT_BUDGET)
+#    include "rgb_matrix.h"
+#endif
+
 static struct usb_device_state usb_device_state = {.idle_rate = 0, .leds = 0, .protocol = USB_PROTOCOL_REPORT, .configure_state = USB_DEVICE_STATE_NO_INIT};
 
 __attribute__((weak)) void notify_usb_device_state_change_kb(struct usb_device_state usb_device_state) {
@@ -37,6 +41,10 @@ static void notify_usb_device_state_change(struct usb_device_state usb_device_st
     haptic_notify_usb_device_state_change();
 #endif
 
+#if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_CURRENT_BUDGET)
+    rgb_matrix_notify_usb_device_state_change(usb_device_state);
+#endif
+
     notify_usb_device_state_change_kb(usb_device_state);
 
 #ifdef OS_DETECTION_ENABLE